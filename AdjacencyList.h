@@ -0,0 +1,167 @@
+/*
+	Author: Vishnu Rampersaud
+	AdjacencyList.h header file
+	Reads a graph file into an adjacency list; shared by all of the graph programs
+*/
+#ifndef ADJACENCY_LIST_H
+#define ADJACENCY_LIST_H
+
+#include "Vertex.h"
+#include "NameTable.h"
+#include "WeightTraits.h"
+#include "Stats.h"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cstdlib>
+#include <cctype>
+using namespace std;
+
+// @ line: a line of the graph file
+// @ position: index in the line to start from; updated to the index just past the token
+// @ token_begin: set to the index of the first character of the token
+// Finds the next whitespace separated token in a line
+// Returns false if there are no more tokens in the line
+inline bool next_token(const string& line, size_t& position, size_t& token_begin)
+{
+	while (position < line.size() && isspace(static_cast<unsigned char>(line[position]))) {
+		position++;
+	}
+	if (position == line.size()) {
+		return false;
+	}
+
+	token_begin = position;
+	while (position < line.size() && !isspace(static_cast<unsigned char>(line[position]))) {
+		position++;
+	}
+	return true;
+}
+
+// @graph_filename: name of the graph file
+// @adjacency_list: Empty vector to create adjacency list with
+// @names: Empty name table; receives the label of every vertex in the graph
+// Weight is the type the edge weights are stored as; see WeightTraits.h
+// This function stores the vertices of a graph into an adjacency list
+// Vertex labels can be any whitespace free token; each label is interned into a dense ID,
+// and the ID is used as the index of the vertex in the adjacency list
+// Vertices are numbered in the order their lines appear in the file; see sort_by_integer_label() for the
+// order FindPaths prints them in
+// Returns false, after printing the edge, if a weight is negative (or not a number), since the
+// shortest path algorithms and the integer weight types need weights of 0 or more
+template <typename Weight>
+bool createAdjacencyList(const string& graph_filename, vector<Vertex<int, Weight>>& adjacency_list, NameTable& names)
+{
+	// Open graph text file that has the specifications of the graph, vertices, edges, and weights
+	ifstream graph_;
+	graph_.open(graph_filename);
+
+	string line;
+	int counter = 0, number_of_vertices = 0;
+	size_t position, token_begin;
+
+	// First pass: give each vertex that has its own line an ID, in file order
+	STATS_PHASE(name_table_timer, "build_name_table");
+	while (getline(graph_, line))
+	{
+		position = 0;
+		if (!next_token(line, position, token_begin)) { continue; }
+
+		// counter to keep track of which line the program is reading in the file
+		counter++;
+
+		// The first line gives the number of vertices for the graph
+		if (counter == 1) {
+			number_of_vertices = atoi(line.c_str() + token_begin);
+			names = NameTable(number_of_vertices);
+			continue;
+		}
+
+		// First element in the line is the vertex name
+		names.intern(line.data() + token_begin, position - token_begin);
+	}
+
+	STATS_STOP(name_table_timer);
+
+	adjacency_list.clear();
+	adjacency_list.reserve(names.size());
+
+	// Second pass: store the adjacent vertices of each vertex and the corresponding weights
+	STATS_PHASE(edges_timer, "parse_edges");
+	graph_.clear();
+	graph_.seekg(0);
+	counter = 0;
+	while (getline(graph_, line))
+	{
+		position = 0;
+		if (!next_token(line, position, token_begin)) { continue; }
+
+		counter++;
+		if (counter == 1) { continue; }
+
+		int vertex_id = names.intern(line.data() + token_begin, position - token_begin);
+
+		// A vertex may already have been added as the target of an earlier edge
+		while (adjacency_list.size() <= static_cast<size_t>(vertex_id)) {
+			adjacency_list.push_back(Vertex<int, Weight>(adjacency_list.size()));
+		}
+
+		// Add each adjacent vertex and its weight into the Vertex object
+		while (next_token(line, position, token_begin)) {
+
+			int adjacent_id = names.intern(line.data() + token_begin, position - token_begin);
+
+			Weight adjacent_weight = 0;
+			if (next_token(line, position, token_begin)) {
+				double weight = strtod(line.c_str() + token_begin, nullptr);
+				if (!(weight >= 0)) {
+					cout << "Edge " << names.name(vertex_id) << " -> " << names.name(adjacent_id) << " in " << graph_filename
+						<< " has weight " << line.substr(token_begin, position - token_begin) << "; weights must not be negative" << endl;
+					return false;
+				}
+				adjacent_weight = WeightTraits<Weight>::from_double(weight);
+			}
+
+			adjacency_list[vertex_id].add_adjacent_vertex(adjacent_id, adjacent_weight);
+		}
+	}
+
+	// Vertices that only appear as the target of an edge have no adjacent vertices
+	while (adjacency_list.size() < static_cast<size_t>(names.size())) {
+		adjacency_list.push_back(Vertex<int, Weight>(adjacency_list.size()));
+	}
+
+	// Close the graph file
+	graph_.close();
+	return true;
+}
+
+// @ adjacency_list: an adjacency list that represents a graph
+// @ encoding: how to store the edge weights
+// Stores the adjacent vertices of every vertex in compressed form (see CompressedAdjacency.h)
+// Returns the number of bytes used by the adjacent vertices before and after compression
+template <typename Weight>
+pair<size_t, size_t> compress_graph(vector<Vertex<int, Weight>>& adjacency_list, WeightEncoding encoding)
+{
+	STATS_PHASE(compress_timer, "compress");
+	size_t bytes_before = 0, bytes_after = 0;
+	for (size_t v = 0; v < adjacency_list.size(); v++) {
+		bytes_before += adjacency_list[v].adjacency_bytes();
+		adjacency_list[v].compress_adjacency(encoding);
+		bytes_after += adjacency_list[v].adjacency_bytes();
+	}
+	return pair<size_t, size_t>(bytes_before, bytes_after);
+}
+
+// @ encoding: how the edge weights were stored
+// @ bytes: the number of bytes before and after compression, as returned by compress_graph
+// Prints how much memory compression saved
+inline void print_compression(WeightEncoding encoding, const pair<size_t, size_t>& bytes)
+{
+	double saved = bytes.first == 0 ? 0 : 100.0 * (1.0 - static_cast<double>(bytes.second) / bytes.first);
+	cout << "Compressed adjacency storage (" << weight_encoding_name(encoding) << " weights): " << bytes.second
+		<< " bytes, was " << bytes.first << " bytes (" << saved << "% saved)\n" << endl;
+}
+
+#endif
@@ -0,0 +1,305 @@
+/*
+	Author: Vishnu Rampersaud
+	AllPairs.h header file
+	All pairs shortest path costs: a cache blocked Floyd-Warshall for dense graphs, vectorized with AVX2 when
+	the processor has it, and repeated searches (DistanceMatrix.h) for sparse graphs
+*/
+#ifndef ALL_PAIRS_H
+#define ALL_PAIRS_H
+
+#include "Vertex.h"
+#include "WeightTraits.h"
+#include "DistanceMatrix.h"
+#include "ThreadPool.h"
+#include "Stats.h"
+#include <string>
+#include <vector>
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+using namespace std;
+
+// Vector instructions are only used by GCC and Clang on x86, where a function can be compiled for AVX2
+// without compiling the whole program for it, and the processor can be asked whether it has AVX2
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define GRAPH_HAVE_AVX2_KERNEL 1
+#include <immintrin.h>
+#endif
+
+enum class AllPairsMethod { AUTO, FLOYD_WARSHALL, DIJKSTRA };
+
+// @ name: name of a method, as given on the command line
+// @ method: set to the method with this name
+// Returns false if there is no method with this name
+inline bool parse_all_pairs_method(const string& name, AllPairsMethod& method)
+{
+	if (name == "auto") { method = AllPairsMethod::AUTO; }
+	else if (name == "floyd") { method = AllPairsMethod::FLOYD_WARSHALL; }
+	else if (name == "dijkstra") { method = AllPairsMethod::DIJKSTRA; }
+	else { return false; }
+	return true;
+}
+
+// Returns true if the processor running the program has AVX2
+inline bool cpu_has_avx2()
+{
+#ifdef GRAPH_HAVE_AVX2_KERNEL
+	static const bool has_avx2 = __builtin_cpu_supports("avx2");
+	return has_avx2;
+#else
+	return false;
+#endif
+}
+
+// MinPlusRow struct
+// The inner loop of Floyd-Warshall: row[j] = min(row[j], a + through[j]) for count costs
+// The general version is plain C++; the weight types with an AVX2 version below use it when the processor has AVX2
+template <typename Weight>
+struct MinPlusRow {
+	static const int lanes = 1;
+
+	static void update(Weight* row, Weight a, const Weight* through, size_t count)
+	{
+		for (size_t j = 0; j < count; j++) {
+			row[j] = min(row[j], WeightTraits<Weight>::add(a, through[j]));
+		}
+	}
+};
+
+#ifdef GRAPH_HAVE_AVX2_KERNEL
+
+__attribute__((target("avx2")))
+inline void min_plus_row_avx2(double* row, double a, const double* through, size_t count)
+{
+	const __m256d a4 = _mm256_set1_pd(a);
+	size_t j = 0;
+	for (; j + 4 <= count; j += 4) {
+		__m256d sum = _mm256_add_pd(a4, _mm256_loadu_pd(through + j));
+		_mm256_storeu_pd(row + j, _mm256_min_pd(_mm256_loadu_pd(row + j), sum));
+	}
+	for (; j < count; j++) {
+		row[j] = min(row[j], a + through[j]);
+	}
+}
+
+__attribute__((target("avx2")))
+inline void min_plus_row_avx2(float* row, float a, const float* through, size_t count)
+{
+	const __m256 a8 = _mm256_set1_ps(a);
+	size_t j = 0;
+	for (; j + 8 <= count; j += 8) {
+		__m256 sum = _mm256_add_ps(a8, _mm256_loadu_ps(through + j));
+		_mm256_storeu_ps(row + j, _mm256_min_ps(_mm256_loadu_ps(row + j), sum));
+	}
+	for (; j < count; j++) {
+		row[j] = min(row[j], a + through[j]);
+	}
+}
+
+// Unsigned addition that saturates at the largest value, which is infinity for integer weights: a sum that
+// wrapped around is smaller than a, so those lanes are set to all ones
+__attribute__((target("avx2")))
+inline void min_plus_row_avx2(uint32_t* row, uint32_t a, const uint32_t* through, size_t count)
+{
+	const __m256i a8 = _mm256_set1_epi32(static_cast<int>(a));
+	const __m256i ones = _mm256_set1_epi32(-1);
+	size_t j = 0;
+	for (; j + 8 <= count; j += 8) {
+		__m256i sum = _mm256_add_epi32(a8, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(through + j)));
+		__m256i no_overflow = _mm256_cmpeq_epi32(_mm256_max_epu32(sum, a8), sum);
+		sum = _mm256_or_si256(sum, _mm256_andnot_si256(no_overflow, ones));
+		__m256i current = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + j));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(row + j), _mm256_min_epu32(current, sum));
+	}
+	for (; j < count; j++) {
+		row[j] = min(row[j], WeightTraits<uint32_t>::add(a, through[j]));
+	}
+}
+
+template <>
+struct MinPlusRow<double> {
+	static const int lanes = 4;
+
+	static void update(double* row, double a, const double* through, size_t count)
+	{
+		if (cpu_has_avx2()) {
+			min_plus_row_avx2(row, a, through, count);
+			return;
+		}
+		for (size_t j = 0; j < count; j++) {
+			row[j] = min(row[j], a + through[j]);
+		}
+	}
+};
+
+template <>
+struct MinPlusRow<float> {
+	static const int lanes = 8;
+
+	static void update(float* row, float a, const float* through, size_t count)
+	{
+		if (cpu_has_avx2()) {
+			min_plus_row_avx2(row, a, through, count);
+			return;
+		}
+		for (size_t j = 0; j < count; j++) {
+			row[j] = min(row[j], a + through[j]);
+		}
+	}
+};
+
+template <>
+struct MinPlusRow<uint32_t> {
+	static const int lanes = 8;
+
+	static void update(uint32_t* row, uint32_t a, const uint32_t* through, size_t count)
+	{
+		if (cpu_has_avx2()) {
+			min_plus_row_avx2(row, a, through, count);
+			return;
+		}
+		for (size_t j = 0; j < count; j++) {
+			row[j] = min(row[j], WeightTraits<uint32_t>::add(a, through[j]));
+		}
+	}
+};
+
+#endif
+
+// Side of the square tiles of the matrix that Floyd-Warshall works on; three tiles of doubles fit in 96 KB
+const size_t ALL_PAIRS_TILE = 64;
+
+// @ matrix: n x n costs, row after row
+// @ n: number of vertices
+// @ row_tile, column_tile: the tile to update
+// @ k_tile: the tile of intermediate vertices to go through
+// Lowers each cost in the tile to the cost through any vertex of k_tile. The vertices of k_tile are taken
+// one after another, as in plain Floyd-Warshall, so the tile may be k_tile's own row or column of tiles.
+template <typename Weight>
+void min_plus_tile(vector<Weight>& matrix, size_t n, size_t row_tile, size_t column_tile, size_t k_tile)
+{
+	const size_t first_column = column_tile * ALL_PAIRS_TILE;
+	const size_t columns = min(ALL_PAIRS_TILE, n - first_column);
+	const size_t last_row = min(n, (row_tile + 1) * ALL_PAIRS_TILE);
+	const size_t last_k = min(n, (k_tile + 1) * ALL_PAIRS_TILE);
+	for (size_t k = k_tile * ALL_PAIRS_TILE; k < last_k; k++) {
+		const Weight* through = &matrix[k * n + first_column];
+		for (size_t i = row_tile * ALL_PAIRS_TILE; i < last_row; i++) {
+			const Weight a = matrix[i * n + k];
+			if (a != WeightTraits<Weight>::infinity()) {
+				MinPlusRow<Weight>::update(&matrix[i * n + first_column], a, through, columns);
+			}
+		}
+	}
+}
+
+// @ adjacency_list: the graph
+// @ pool: threads to update the tiles on
+// @ matrix: receives the n x n costs, row after row; infinity where there is no path
+// Blocked Floyd-Warshall: for each tile of intermediate vertices, first its diagonal tile is updated, then the
+// other tiles of its row and column of tiles (in parallel), then every other tile (in parallel). Each step reads
+// only tiles that are final for it, so the tiles of a step can be updated at the same time.
+template <typename Weight>
+void floyd_warshall(const vector<Vertex<int, Weight>>& adjacency_list, ThreadPool& pool, vector<Weight>& matrix)
+{
+	STATS_PHASE(floyd_timer, "floyd_warshall");
+	const size_t n = adjacency_list.size();
+	matrix.assign(n * n, WeightTraits<Weight>::infinity());
+	for (size_t v = 0; v < n; v++) {
+		matrix[v * n + v] = 0;
+		for (auto edge : adjacency_list[v].adjacent()) {
+			Weight& cost = matrix[v * n + edge.first];
+			cost = min(cost, edge.second);
+		}
+	}
+
+	const size_t tiles = (n + ALL_PAIRS_TILE - 1) / ALL_PAIRS_TILE;
+	for (size_t k = 0; k < tiles; k++) {
+		min_plus_tile(matrix, n, k, k, k);
+		pool.parallel_for(2 * tiles, [&](size_t task, int) {
+			const size_t other = task / 2;
+			if (other == k) {
+				return;
+			}
+			if (task % 2 == 0) {
+				min_plus_tile(matrix, n, k, other, k);
+			}
+			else {
+				min_plus_tile(matrix, n, other, k, k);
+			}
+		});
+		pool.parallel_for(tiles * tiles, [&](size_t task, int) {
+			const size_t row = task / tiles, column = task % tiles;
+			if (row != k && column != k) {
+				min_plus_tile(matrix, n, row, column, k);
+			}
+		});
+	}
+}
+
+// @ adjacency_list: the graph
+// @ threads: number of threads the method will run on
+// Returns the faster method for this graph, estimated from its size, density and the threads: repeated Dijkstra
+// is V searches of about V log V heap work and E edge scans each, which the threads share evenly; Floyd-Warshall
+// is V^3 additions, several at a time with vector instructions, but each tile of intermediate vertices waits for
+// its diagonal tile and then its row and column of tiles, which few threads can share
+template <typename Weight>
+AllPairsMethod choose_all_pairs_method(const vector<Vertex<int, Weight>>& adjacency_list, int threads)
+{
+	const double v = adjacency_list.size();
+	double e = 0;
+	for (size_t i = 0; i < adjacency_list.size(); i++) {
+		e += adjacency_list[i].adjacent_count();
+	}
+	int lanes = 1;
+#ifdef GRAPH_HAVE_AVX2_KERNEL
+	if (cpu_has_avx2()) {
+		lanes = MinPlusRow<Weight>::lanes;
+	}
+#endif
+	// Costs in min-plus steps on a vector of lanes, fitted to the median of repeated single-thread runs on
+	// GenerateGraph random graphs of 400 to 2000 vertices and degree 8 to 50, double weights with AVX2.
+	// Milliseconds, floyd / dijkstra:
+	//     700 vertices:  degree 8: 72 / 118, degree 20: 92 / 144, degree 50: 76 / 164
+	//     1000 vertices: degree 8: 207 / 268, degree 20: 227 / 305, degree 50: 244 / 361
+	//     1500 vertices: degree 8: 776 / 578, degree 20: 775 / 764
+	//     2000 vertices: degree 8: 2077 / 935, degree 20: 2018 / 1472
+	const double heap_step_cost = 25;
+	const double edge_cost = 3;
+	const double search_work = heap_step_cost * v * log2(max(2.0, v)) + edge_cost * e;
+	const double searches_per_thread = ceil(v / threads);
+	const double dijkstra_work = searches_per_thread * search_work;
+
+	// Tile updates on the longest thread, as a fraction of all of them
+	const double tiles = max(1.0, ceil(v / ALL_PAIRS_TILE));
+	const double others = tiles - 1;
+	const double tile_steps = tiles * (1 + ceil(2 * others / threads) + ceil(others * others / threads));
+	const double floyd_work = v * v * v / lanes * tile_steps / (tiles * tiles * tiles);
+	return floyd_work < dijkstra_work ? AllPairsMethod::FLOYD_WARSHALL : AllPairsMethod::DIJKSTRA;
+}
+
+// @ adjacency_list: the graph
+// @ pool: threads to run on
+// @ method: the method to use, or AUTO to choose one
+// @ matrix: receives the n x n costs, row after row; infinity where there is no path
+// Returns the method used
+template <typename Weight>
+AllPairsMethod all_pairs(const vector<Vertex<int, Weight>>& adjacency_list, ThreadPool& pool, AllPairsMethod method, vector<Weight>& matrix)
+{
+	if (method == AllPairsMethod::AUTO) {
+		method = choose_all_pairs_method(adjacency_list, pool.size());
+	}
+	if (method == AllPairsMethod::FLOYD_WARSHALL) {
+		floyd_warshall(adjacency_list, pool, matrix);
+	}
+	else {
+		vector<int> everyone(adjacency_list.size());
+		for (size_t v = 0; v < everyone.size(); v++) {
+			everyone[v] = v;
+		}
+		distance_matrix(adjacency_list, everyone, everyone, pool, matrix);
+	}
+	return method;
+}
+
+#endif
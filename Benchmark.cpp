@@ -0,0 +1,314 @@
+/*
+	Author: Vishnu Rampersaud
+	Measures how the vertex ordering, adjacency compression and weight type affect the graph algorithms
+*/
+
+#include "AdjacencyList.h"
+#include "FindPaths.h"
+#include "TopologicalSort.h"
+#include "VertexOrdering.h"
+#include "BoundedSearch.h"
+#include "BenchmarkTimer.h"
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+using namespace std;
+
+// PerfCounter class
+// Counts the hardware cache misses of the calling thread between start() and stop()
+// If the kernel does not allow performance counters, available() returns false and the counts are 0
+class PerfCounter {
+public:
+
+	// Constructor that opens the cache miss counter
+	PerfCounter() : fd(-1)
+	{
+#ifdef __linux__
+		perf_event_attr attr;
+		memset(&attr, 0, sizeof(attr));
+		attr.type = PERF_TYPE_HARDWARE;
+		attr.size = sizeof(attr);
+		attr.config = PERF_COUNT_HW_CACHE_MISSES;
+		attr.disabled = 1;
+		attr.exclude_kernel = 1;
+		attr.exclude_hv = 1;
+		fd = syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+#endif
+	}
+
+	// Destructor that closes the counter
+	~PerfCounter()
+	{
+#ifdef __linux__
+		if (fd != -1) { close(fd); }
+#endif
+	}
+
+	// Returns true if cache misses can be counted on this machine
+	bool available() const
+	{
+		return fd != -1;
+	}
+
+	// Resets the counter and starts counting
+	void start()
+	{
+#ifdef __linux__
+		if (fd == -1) { return; }
+		ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+		ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+	}
+
+	// Stops counting and returns the number of cache misses since start()
+	long long stop()
+	{
+		long long count = 0;
+#ifdef __linux__
+		if (fd == -1) { return 0; }
+		ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+		if (read(fd, &count, sizeof(count)) != sizeof(count)) {
+			count = 0;
+		}
+#endif
+		return count;
+	}
+
+private:
+	// File descriptor of the counter, or -1 if it could not be opened
+	int fd;
+};
+
+// @ adjacency_list: the graph as loaded from the file
+// @ names: labels of the vertices in the graph
+// @ ordering: ordering to measure
+// @ repeats: number of times each algorithm is run
+// @ counter: cache miss counter
+// Relabels a copy of the graph with the ordering, runs Dijkstra's algorithm and topSort() on it,
+// and prints one row of the results table
+// The search is bounded_dijkstra() with no radius: its queue holds vertex IDs and it reads the edges from
+// the graph in place, so the times show how the ordering lays out the graph, not copies of whole vertices
+template <typename Weight>
+void benchmark_ordering(const vector<Vertex<int, Weight>>& adjacency_list, const NameTable& names,
+	VertexOrdering ordering, int repeats, PerfCounter& counter)
+{
+	vector<Vertex<int, Weight>> graph = adjacency_list;
+	NameTable graph_names = names;
+
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	vector<int> new_id = reorder_vertices(graph, graph_names, ordering);
+	double reorder_ms = elapsed_ms(start);
+
+	// Every ordering runs Dijkstra from the same vertex: the first vertex in the file
+	const int starting_vertex = new_id.empty() ? 0 : new_id[0];
+
+	SearchWorkspace<Weight> workspace(graph.size());
+	vector<int> reached;
+	double dijkstra_ms = 0, topsort_ms = 0;
+	long long dijkstra_misses = 0, topsort_misses = 0;
+	for (int r = 0; r < repeats && !graph.empty(); r++) {
+		start = chrono::steady_clock::now();
+		counter.start();
+		bounded_dijkstra(graph, workspace, starting_vertex, WeightTraits<Weight>::infinity(), reached);
+		dijkstra_misses += counter.stop();
+		dijkstra_ms += elapsed_ms(start);
+		benchmark_sink = reached.size();
+
+		vector<int> topological_order;
+		start = chrono::steady_clock::now();
+		counter.start();
+		topSort(graph, topological_order);
+		topsort_misses += counter.stop();
+		topsort_ms += elapsed_ms(start);
+	}
+
+	cout << left << setw(10) << ordering_name(ordering) << right << fixed << setprecision(3)
+		<< setw(12) << reorder_ms
+		<< setw(14) << dijkstra_ms / repeats
+		<< setw(14) << topsort_ms / repeats;
+	if (counter.available()) {
+		cout << setw(18) << dijkstra_misses / repeats << setw(18) << topsort_misses / repeats;
+	}
+	else {
+		cout << setw(18) << "n/a" << setw(18) << "n/a";
+	}
+	cout << endl;
+}
+
+// @ adjacency_list: the graph as loaded from the file
+// @ compress: false to measure the plain adjacency list
+// @ encoding: how the weights are stored when compress is true
+// @ repeats: number of times each measurement is run
+// Compresses a copy of the graph and prints one row of the compression table:
+// memory used by the edges, time to compress, decode throughput of a full sweep over every edge,
+// and the running time of dijkstra() on the compressed graph
+template <typename Weight>
+void benchmark_encoding(const vector<Vertex<int, Weight>>& adjacency_list, bool compress, WeightEncoding encoding, int repeats)
+{
+	vector<Vertex<int, Weight>> graph = adjacency_list;
+
+	size_t bytes = 0;
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	if (compress) {
+		bytes = compress_graph(graph, encoding).second;
+	}
+	else {
+		for (size_t v = 0; v < graph.size(); v++) {
+			bytes += graph[v].adjacency_bytes();
+		}
+	}
+	double compress_ms = elapsed_ms(start);
+
+	// Decode every edge; the checksum keeps the compiler from skipping the loop
+	long long edges_read = 0;
+	double checksum = 0;
+	start = chrono::steady_clock::now();
+	for (int r = 0; r < repeats; r++) {
+		for (size_t v = 0; v < graph.size(); v++) {
+			for (auto edge : graph[v].adjacent()) {
+				checksum += edge.first + edge.second;
+				edges_read++;
+			}
+		}
+	}
+	double sweep_ms = elapsed_ms(start);
+	benchmark_sink = checksum;
+
+	BinaryHeap<Vertex<int, Weight>> priority_queue;
+	start = chrono::steady_clock::now();
+	for (int r = 0; r < repeats && !graph.empty(); r++) {
+		dijkstra(0, priority_queue, graph);
+	}
+	double dijkstra_ms = elapsed_ms(start) / repeats;
+
+	double edges_per_second = sweep_ms > 0 ? edges_read / (sweep_ms / 1000.0) : 0;
+	cout << left << setw(10) << (compress ? weight_encoding_name(encoding) : "none") << right << fixed << setprecision(3)
+		<< setw(14) << bytes
+		<< setw(8) << setprecision(2) << (edges_read == 0 ? 0.0 : static_cast<double>(bytes) * repeats / edges_read)
+		<< setw(14) << setprecision(3) << compress_ms
+		<< setw(16) << setprecision(1) << edges_per_second / 1e6
+		<< setw(14) << setprecision(3) << dijkstra_ms << endl;
+}
+
+// @ graph_filename: name of the graph file
+// @ type_name: name of the weight type, for the table
+// @ repeats: number of times each algorithm is run
+// Loads the graph with Weight as the weight type and prints one row of the weight type table:
+// the size of one edge, of one Vertex and of one queue entry of the search, the memory used by the edges,
+// and the running time of Dijkstra's algorithm (bounded_dijkstra() with no radius) and topSort()
+template <typename Weight>
+void benchmark_weight_type(const string& graph_filename, const char* type_name, int repeats)
+{
+	vector<Vertex<int, Weight>> graph;
+	NameTable names;
+	if (!createAdjacencyList(graph_filename, graph, names)) {
+		return;
+	}
+
+	size_t bytes = 0;
+	for (size_t v = 0; v < graph.size(); v++) {
+		bytes += graph[v].adjacency_bytes();
+	}
+
+	SearchWorkspace<Weight> workspace(graph.size());
+	vector<int> reached;
+	double dijkstra_ms = 0, topsort_ms = 0;
+	for (int r = 0; r < repeats && !graph.empty(); r++) {
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		bounded_dijkstra(graph, workspace, 0, WeightTraits<Weight>::infinity(), reached);
+		dijkstra_ms += elapsed_ms(start);
+		benchmark_sink = reached.size();
+
+		vector<int> topological_order;
+		start = chrono::steady_clock::now();
+		topSort(graph, topological_order);
+		topsort_ms += elapsed_ms(start);
+	}
+
+	cout << left << setw(10) << type_name << right
+		<< setw(12) << sizeof(pair<int, Weight>)
+		<< setw(14) << sizeof(Vertex<int, Weight>)
+		<< setw(14) << sizeof(QueueEntry<Weight>)
+		<< setw(14) << bytes << fixed << setprecision(3)
+		<< setw(14) << dijkstra_ms / repeats
+		<< setw(14) << topsort_ms / repeats << endl;
+}
+
+int main(int argc, char** argv)
+{
+	// Checks to see if the correct number of arguments are entered
+	if (argc != 2 && argc != 3) {
+		cout << "Usage: " << argv[0] << " <GRAPH_FILE> [REPEATS]" << endl;
+		return 0;
+	}
+
+	// Store arguments into variables
+	const string graph_filename(argv[1]);
+	const int repeats = argc == 3 ? max(1, atoi(argv[2])) : 3;
+
+	ifstream file(graph_filename);
+	if (!file.is_open()) {
+		cout << graph_filename << " does not exist in the current directory." << endl;
+		cout << "Program will terminate" << endl;
+		return 0;
+	}
+	file.close();
+
+	// Load the graph once; every ordering starts from a copy of it
+	vector<Vertex<int, weight_type>> adjacency_list;
+	NameTable names;
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	if (!createAdjacencyList(graph_filename, adjacency_list, names)) {
+		cout << "Program will terminate" << endl;
+		return 0;
+	}
+	double load_ms = elapsed_ms(start);
+
+	long long number_of_edges = 0;
+	for (size_t v = 0; v < adjacency_list.size(); v++) {
+		number_of_edges += adjacency_list[v].adjacent_count();
+	}
+
+	cout << "\nInput Graph file: " << graph_filename << "\nVertices: " << adjacency_list.size()
+		<< "\nEdges: " << number_of_edges << "\nLoad time (ms): " << fixed << setprecision(3) << load_ms
+		<< "\nRepeats: " << repeats << "\n" << endl;
+
+	PerfCounter counter;
+	cout << left << setw(10) << "ordering" << right << setw(12) << "reorder_ms" << setw(14) << "dijkstra_ms"
+		<< setw(14) << "topsort_ms" << setw(18) << "dijkstra_misses" << setw(18) << "topsort_misses" << endl;
+
+	const VertexOrdering orderings[] = { VertexOrdering::FILE_ORDER, VertexOrdering::BFS, VertexOrdering::RCM, VertexOrdering::HUB };
+	for (size_t i = 0; i < sizeof(orderings) / sizeof(orderings[0]); i++) {
+		benchmark_ordering(adjacency_list, names, orderings[i], repeats, counter);
+	}
+
+	cout << "\n" << left << setw(10) << "encoding" << right << setw(14) << "edge_bytes" << setw(8) << "B/edge"
+		<< setw(14) << "compress_ms" << setw(16) << "decode_Medge/s" << setw(14) << "dijkstra_ms" << endl;
+	benchmark_encoding(adjacency_list, false, WeightEncoding::DOUBLE, repeats);
+	const WeightEncoding encodings[] = { WeightEncoding::DOUBLE, WeightEncoding::FLOAT, WeightEncoding::UINT16 };
+	for (size_t i = 0; i < sizeof(encodings) / sizeof(encodings[0]); i++) {
+		benchmark_encoding(adjacency_list, true, encodings[i], repeats);
+	}
+
+	// Each weight type loads its own copy of the graph; integer types round the weights in the file
+	cout << "\n" << left << setw(10) << "weight" << right << setw(12) << "edge_size" << setw(14) << "vertex_size"
+		<< setw(14) << "entry_size" << setw(14) << "edge_bytes" << setw(14) << "dijkstra_ms" << setw(14) << "topsort_ms" << endl;
+	benchmark_weight_type<double>(graph_filename, "double", repeats);
+	benchmark_weight_type<float>(graph_filename, "float", repeats);
+	benchmark_weight_type<uint32_t>(graph_filename, "uint32_t", repeats);
+	benchmark_weight_type<uint16_t>(graph_filename, "uint16_t", repeats);
+
+	return 0;
+}
@@ -0,0 +1,318 @@
+/*
+	Author: Vishnu Rampersaud
+	Times each phase of the graph programs over repeated runs and writes the results
+	as JSON or CSV, so that runs on different versions of the code can be compared
+*/
+
+#include "AdjacencyList.h"
+#include "CreateGraphAndTest.h"
+#include "FindPaths.h"
+#include "TopologicalSort.h"
+#include "SpanningTree.h"
+#include "BenchmarkTimer.h"
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <ctime>
+#include <cmath>
+#include <algorithm>
+#include <cstdlib>
+#include <cstdio>
+using namespace std;
+
+// Turns the weight type macro into a string for the results
+#define GRAPH_STRINGIFY(x) GRAPH_STRINGIFY_VALUE(x)
+#define GRAPH_STRINGIFY_VALUE(x) #x
+
+// Running times of one phase; one entry per repeat
+struct PhaseTimes {
+	string name;
+	vector<double> ms;
+};
+
+// Summary of the running times of one phase
+struct PhaseSummary {
+	double min_ms, median_ms, mean_ms, max_ms, stddev_ms;
+};
+
+// @ phase: running times of a phase
+// Returns the smallest, median, mean and largest time, and the standard deviation
+PhaseSummary summarize(const PhaseTimes& phase)
+{
+	PhaseSummary summary = { 0, 0, 0, 0, 0 };
+	if (phase.ms.empty()) {
+		return summary;
+	}
+	vector<double> sorted = phase.ms;
+	sort(sorted.begin(), sorted.end());
+	const size_t runs = sorted.size();
+
+	summary.min_ms = sorted.front();
+	summary.max_ms = sorted.back();
+	summary.median_ms = runs % 2 == 1 ? sorted[runs / 2] : (sorted[runs / 2 - 1] + sorted[runs / 2]) / 2;
+	for (size_t i = 0; i < runs; i++) {
+		summary.mean_ms += sorted[i];
+	}
+	summary.mean_ms /= runs;
+	for (size_t i = 0; i < runs; i++) {
+		summary.stddev_ms += (sorted[i] - summary.mean_ms) * (sorted[i] - summary.mean_ms);
+	}
+	summary.stddev_ms = sqrt(summary.stddev_ms / runs);
+	return summary;
+}
+
+// Returns text as a quoted JSON string
+string json_string(const string& text)
+{
+	string quoted = "\"";
+	for (size_t i = 0; i < text.size(); i++) {
+		const char c = text[i];
+		if (c == '"' || c == '\\') {
+			quoted += '\\';
+			quoted += c;
+		}
+		else if (static_cast<unsigned char>(c) < 0x20) {
+			char escaped[8];
+			snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+			quoted += escaped;
+		}
+		else {
+			quoted += c;
+		}
+	}
+	return quoted + "\"";
+}
+
+// Returns the current time as an ISO 8601 string in UTC
+string current_timestamp()
+{
+	time_t now = time(nullptr);
+	char text[32];
+	strftime(text, sizeof(text), "%Y-%m-%dT%H:%M:%SZ", gmtime(&now));
+	return text;
+}
+
+// Description of a benchmark run, written with every result
+struct RunInfo {
+	string timestamp, tag, graph_filename, query_filename;
+	size_t vertices;
+	long long edges;
+	int repeats;
+	long peak_rss_kb;
+};
+
+// @ out: where the results are written
+// @ info: description of the run
+// @ phases: running times of each phase
+// Writes the results as one JSON object on one line, so a results file can collect one line per run
+void write_json(ostream& out, const RunInfo& info, const vector<PhaseTimes>& phases)
+{
+	out << fixed << setprecision(3);
+	out << "{\"timestamp\": " << json_string(info.timestamp)
+		<< ", \"tag\": " << json_string(info.tag)
+		<< ", \"graph\": " << json_string(info.graph_filename)
+		<< ", \"queries\": " << json_string(info.query_filename)
+		<< ", \"weight_type\": " << json_string(GRAPH_STRINGIFY(GRAPH_WEIGHT_TYPE))
+		<< ", \"vertices\": " << info.vertices
+		<< ", \"edges\": " << info.edges
+		<< ", \"repeats\": " << info.repeats
+		<< ", \"peak_rss_kb\": " << info.peak_rss_kb
+		<< ", \"phases\": {";
+	for (size_t i = 0; i < phases.size(); i++) {
+		PhaseSummary summary = summarize(phases[i]);
+		out << (i == 0 ? "" : ", ") << json_string(phases[i].name) << ": {"
+			<< "\"min_ms\": " << summary.min_ms
+			<< ", \"median_ms\": " << summary.median_ms
+			<< ", \"mean_ms\": " << summary.mean_ms
+			<< ", \"max_ms\": " << summary.max_ms
+			<< ", \"stddev_ms\": " << summary.stddev_ms << "}";
+	}
+	out << "}}" << endl;
+}
+
+// @ out: where the results are written
+// @ info: description of the run
+// @ phases: running times of each phase
+// @ header: true to write the column names first
+// Writes the results as CSV, one row per phase
+void write_csv(ostream& out, const RunInfo& info, const vector<PhaseTimes>& phases, bool header)
+{
+	if (header) {
+		out << "timestamp,tag,graph,queries,weight_type,vertices,edges,repeats,peak_rss_kb,phase,min_ms,median_ms,mean_ms,max_ms,stddev_ms" << endl;
+	}
+	out << fixed << setprecision(3);
+	for (size_t i = 0; i < phases.size(); i++) {
+		PhaseSummary summary = summarize(phases[i]);
+		out << info.timestamp << "," << info.tag << "," << info.graph_filename << "," << info.query_filename << ","
+			<< GRAPH_STRINGIFY(GRAPH_WEIGHT_TYPE) << "," << info.vertices << "," << info.edges << "," << info.repeats << ","
+			<< info.peak_rss_kb << "," << phases[i].name << "," << summary.min_ms << "," << summary.median_ms << "," << summary.mean_ms << ","
+			<< summary.max_ms << "," << summary.stddev_ms << endl;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	// Checks to see if the correct number of arguments are entered
+	const string usage = string("Usage: ") + argv[0] + " <GRAPH_FILE> [--queries=<ADJACENCY_QUERY_FILE>]"
+		+ " [--start=<STARTING_VERTEX>] [--repeats=<RUNS>] [--format=json|csv] [--output=<RESULTS_FILE>] [--tag=<TAG>]";
+	if (argc < 2) {
+		cout << usage << endl;
+		return 0;
+	}
+
+	// Store arguments into variables
+	RunInfo info;
+	info.graph_filename = argv[1];
+	info.repeats = 5;
+	info.timestamp = current_timestamp();
+
+	// Read the options that follow the required arguments
+	string starting_label, format = "json", output_filename;
+	for (int i = 2; i < argc; i++) {
+		const string option(argv[i]);
+		if (option.compare(0, 10, "--queries=") == 0) {
+			info.query_filename = option.substr(10);
+			continue;
+		}
+		if (option.compare(0, 8, "--start=") == 0) {
+			starting_label = option.substr(8);
+			continue;
+		}
+		if (option.compare(0, 10, "--repeats=") == 0 && atoi(option.c_str() + 10) > 0) {
+			info.repeats = atoi(option.c_str() + 10);
+			continue;
+		}
+		if (option == "--format=json" || option == "--format=csv") {
+			format = option.substr(9);
+			continue;
+		}
+		if (option.compare(0, 9, "--output=") == 0) {
+			output_filename = option.substr(9);
+			continue;
+		}
+		if (option.compare(0, 6, "--tag=") == 0) {
+			info.tag = option.substr(6);
+			continue;
+		}
+		cout << "Unknown option: " << option << endl;
+		cout << usage << endl;
+		return 0;
+	}
+
+	// Test to see if the input files exist
+	const string inputs[2] = { info.graph_filename, info.query_filename };
+	for (int i = 0; i < 2; i++) {
+		if (inputs[i].empty()) { continue; }
+		ifstream file(inputs[i]);
+		if (!file.is_open()) {
+			cout << inputs[i] << " does not exist in the current directory." << endl;
+			cout << "Program will terminate" << endl;
+			return 0;
+		}
+	}
+
+	PhaseTimes load = { "load", vector<double>() };
+	PhaseTimes shortest_paths = { "dijkstra", vector<double>() };
+	PhaseTimes topological_sort = { "topsort", vector<double>() };
+	PhaseTimes adjacency_queries = { "test_graph", vector<double>() };
+	PhaseTimes spanning_trees[] = { { "mst_prim", vector<double>() }, { "mst_boruvka", vector<double>() },
+		{ "mst_kruskal", vector<double>() } };
+	const SpanningTreeMethod spanning_tree_methods[] = { SpanningTreeMethod::PRIM, SpanningTreeMethod::BORUVKA,
+		SpanningTreeMethod::KRUSKAL };
+	ThreadPool pool;
+
+	vector<Vertex<int, weight_type>> adjacency_list;
+	NameTable names;
+	BinaryHeap<Vertex<int, weight_type>> priority_queue;
+	for (int r = 0; r < info.repeats; r++) {
+
+		// Every repeat loads the graph again, so the load phase includes building the adjacency list
+		adjacency_list.clear();
+		names = NameTable();
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		if (!createAdjacencyList(info.graph_filename, adjacency_list, names)) {
+			return 0;
+		}
+		load.ms.push_back(elapsed_ms(start));
+		if (adjacency_list.empty()) {
+			cout << info.graph_filename << " has no vertices" << endl;
+			return 0;
+		}
+
+		// Start from the given vertex, or else the first vertex in the file
+		int starting_vertex = starting_label.empty() ? 0 : names.find(starting_label);
+		if (starting_vertex == NO_VERTEX) {
+			cout << "Vertex " << starting_label << " not found in " << info.graph_filename << endl;
+			return 0;
+		}
+		start = chrono::steady_clock::now();
+		dijkstra(starting_vertex, priority_queue, adjacency_list);
+		shortest_paths.ms.push_back(elapsed_ms(start));
+		benchmark_sink = static_cast<double>(adjacency_list.back().get_minPathCost());
+
+		vector<int> topological_order;
+		start = chrono::steady_clock::now();
+		benchmark_sink = topSort(adjacency_list, topological_order);
+		topological_sort.ms.push_back(elapsed_ms(start));
+
+		// Each minimum spanning tree algorithm on the same graph, so they can be compared
+		for (int m = 0; m < 3; m++) {
+			start = chrono::steady_clock::now();
+			benchmark_sink = spanning_forest(adjacency_list, spanning_tree_methods[m], pool).total_weight;
+			spanning_trees[m].ms.push_back(elapsed_ms(start));
+		}
+
+		// The answers are written to memory, so the time does not depend on the terminal
+		if (!info.query_filename.empty()) {
+			ostringstream answers;
+			start = chrono::steady_clock::now();
+			test_graph(info.query_filename, adjacency_list, names, answers);
+			adjacency_queries.ms.push_back(elapsed_ms(start));
+			benchmark_sink = answers.str().size();
+		}
+	}
+
+	info.peak_rss_kb = peak_rss_kilobytes();
+	info.vertices = adjacency_list.size();
+	info.edges = 0;
+	for (size_t v = 0; v < adjacency_list.size(); v++) {
+		info.edges += adjacency_list[v].adjacent_count();
+	}
+
+	vector<PhaseTimes> phases;
+	phases.push_back(load);
+	phases.push_back(shortest_paths);
+	phases.push_back(topological_sort);
+	for (int m = 0; m < 3; m++) {
+		phases.push_back(spanning_trees[m]);
+	}
+	if (!info.query_filename.empty()) {
+		phases.push_back(adjacency_queries);
+	}
+
+	// Results go to standard output, or are added to the end of the results file
+	if (output_filename.empty()) {
+		if (format == "csv") { write_csv(cout, info, phases, true); }
+		else { write_json(cout, info, phases); }
+		return 0;
+	}
+	bool new_file = true;
+	{
+		ifstream existing(output_filename);
+		new_file = !existing.is_open() || existing.peek() == ifstream::traits_type::eof();
+	}
+	ofstream results(output_filename, ios::app);
+	if (!results.is_open()) {
+		cout << "Could not write " << output_filename << endl;
+		return 1;
+	}
+	if (format == "csv") { write_csv(results, info, phases, new_file); }
+	else { write_json(results, info, phases); }
+	cout << info.graph_filename << ": " << info.repeats << " runs added to " << output_filename << endl;
+
+	return 0;
+}
@@ -0,0 +1,22 @@
+/*
+	Author: Vishnu Rampersaud
+	BenchmarkTimer.h header file
+	Timing helpers shared by the benchmark programs
+*/
+#ifndef BENCHMARK_TIMER_H
+#define BENCHMARK_TIMER_H
+
+#include <chrono>
+using namespace std;
+
+// Results that are computed only to be timed are stored here, so the compiler cannot skip computing them
+// Each benchmark program is a single source file, so every program has exactly one
+static volatile double benchmark_sink;
+
+// Returns the number of milliseconds since start
+inline double elapsed_ms(const chrono::steady_clock::time_point& start)
+{
+	return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+#endif
@@ -0,0 +1,136 @@
+/*
+	Author: Vishnu Rampersaud
+	BoundedSearch.h header file
+	Finds every vertex within a given cost of a starting vertex (an isochrone), touching only that region
+	of the graph
+*/
+#ifndef BOUNDED_SEARCH_H
+#define BOUNDED_SEARCH_H
+
+#include "Vertex.h"
+#include "NameTable.h"
+#include "WeightTraits.h"
+#include "SearchWorkspace.h"
+#include "Stats.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+using namespace std;
+
+// @ adjacency_list: the graph to search
+// @ workspace: search state sized for the graph; reset here, and holds the costs and paths afterwards
+// @ starting_vertex: ID of the vertex to search from
+// @ radius: largest cost to include
+// @ reached: receives the IDs of the vertices within radius, in order of cost
+// Dijkstra's algorithm that only queues a vertex once a path to it within radius is found, and stops when
+// no queued vertex is within radius. Unlike dijkstra(), which queues every vertex of the graph first, the
+// work is proportional to the vertices reached and their edges, not to the size of the graph.
+template <typename Weight>
+void bounded_dijkstra(const vector<Vertex<int, Weight>>& adjacency_list, SearchWorkspace<Weight>& workspace,
+	int starting_vertex, Weight radius, vector<int>& reached)
+{
+	workspace.reset();
+	reached.clear();
+	workspace.improve(starting_vertex, 0, NO_VERTEX);
+
+	QueueEntry<Weight> top;
+	while (workspace.next(top)) {
+		if (radius < top.distance) {
+			break;
+		}
+		STATS_COUNT(vertices_settled);
+		reached.push_back(top.id);
+		for (auto edge : adjacency_list[top.id].adjacent()) {
+			Weight distance = WeightTraits<Weight>::add(top.distance, edge.second);
+			if (!(radius < distance)) {
+				STATS_COUNT(edges_relaxed);
+				workspace.improve(edge.first, distance, top.id);
+			}
+		}
+	}
+}
+
+// @ workspace: the workspace of a finished bounded_dijkstra()
+// @ reached: the vertices it reached
+// @ names: labels of the vertices in the graph
+// Prints each reached vertex with its path and cost, in order of cost
+template <typename Weight>
+void printReached(const SearchWorkspace<Weight>& workspace, const vector<int>& reached, const NameTable& names)
+{
+	STATS_PHASE(output_timer, "output");
+	vector<int> path;
+	for (size_t i = 0; i < reached.size(); i++) {
+		path.clear();
+		for (int v = reached[i]; v != NO_VERTEX; v = workspace.path(v)) {
+			path.push_back(v);
+		}
+		cout << names.name(reached[i]) << ": ";
+		for (size_t j = path.size(); j > 0; j--) {
+			cout << names.name(path[j - 1]) << (j > 1 ? ", " : "");
+		}
+		cout << " (Cost: " << workspace.distance(reached[i]) << ")" << endl;
+	}
+}
+
+// @ workspace: the workspace of a finished bounded_dijkstra()
+// @ reached: the vertices it reached
+// @ radius: the radius it was given
+// @ bands: number of equal cost bands to split the radius into
+// Prints how many vertices fall in each band, e.g. the area reachable in each 5 minute step
+template <typename Weight>
+void printIsochrones(const SearchWorkspace<Weight>& workspace, const vector<int>& reached, Weight radius, int bands)
+{
+	vector<size_t> counts(bands, 0);
+	for (size_t i = 0; i < reached.size(); i++) {
+		int band = radius > 0 ? static_cast<int>(static_cast<double>(workspace.distance(reached[i])) / radius * bands) : 0;
+		counts[min(band, bands - 1)]++;
+	}
+	size_t total = 0;
+	for (int b = 0; b < bands; b++) {
+		total += counts[b];
+		cout << "Cost " << static_cast<double>(radius) * b / bands << " to " << static_cast<double>(radius) * (b + 1) / bands
+			<< ": " << counts[b] << " vertices (" << total << " in total)" << endl;
+	}
+}
+
+// @ query_filename: file with one query per line, "<vertex> <radius>"
+// @ adjacency_list: the graph to search
+// @ names: labels of the vertices in the graph
+// Runs a bounded search for every query, reusing one workspace, and prints the number of vertices each reached
+// and the time it took. Returns the number of queries run.
+template <typename Weight>
+size_t runRadiusQueries(const string& query_filename, const vector<Vertex<int, Weight>>& adjacency_list, const NameTable& names)
+{
+	STATS_PHASE(query_timer, "radius_queries");
+	ifstream query_file(query_filename);
+	SearchWorkspace<Weight> workspace(adjacency_list.size());
+	vector<int> reached;
+	size_t queries = 0;
+	string line;
+	while (getline(query_file, line)) {
+		istringstream query(line);
+		string label;
+		double radius;
+		if (!(query >> label >> radius)) {
+			continue;
+		}
+		int starting_vertex = names.find(label);
+		if (starting_vertex == NO_VERTEX) {
+			cout << label << ": vertex not found" << endl;
+			continue;
+		}
+		auto start = chrono::steady_clock::now();
+		bounded_dijkstra(adjacency_list, workspace, starting_vertex, WeightTraits<Weight>::from_double(radius), reached);
+		double microseconds = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count();
+		cout << label << " within " << radius << ": " << reached.size() << " vertices, " << workspace.touched().size()
+			<< " touched, " << microseconds << " us" << endl;
+		queries++;
+	}
+	return queries;
+}
+
+#endif
@@ -0,0 +1,268 @@
+/*
+	Author: Vishnu Rampersaud
+	BreadthFirstSearch.h header file
+	Direction-optimizing breadth first search: the number of edges (hops) from a starting vertex to every
+	vertex, ignoring the weights, computed in parallel
+*/
+#ifndef BREADTH_FIRST_SEARCH_H
+#define BREADTH_FIRST_SEARCH_H
+
+#include "Vertex.h"
+#include "NameTable.h"
+#include "EdgeArrays.h"
+#include "ThreadPool.h"
+#include "Stats.h"
+#include <iostream>
+#include <vector>
+#include <atomic>
+#include <cstdint>
+#include <algorithm>
+using namespace std;
+
+// Work done by one search
+struct BFSStats {
+	int levels;
+	int top_down_steps;
+	int bottom_up_steps;
+	size_t vertices_reached;
+};
+
+// BreadthFirstSearch class
+// Each step of a breadth first search finds the vertices one hop further than the last step (the frontier).
+// A top-down step goes through the edges out of the frontier; a bottom-up step goes through the vertices not yet
+// reached and looks for an edge into them from the frontier, stopping at the first one. When the frontier is a
+// large part of the graph, bottom-up looks at far fewer edges, so the search switches between the two by comparing
+// the edges out of the frontier with the edges into the unreached vertices (Beamer, Asanovic and Patterson).
+//
+// The frontier is kept as a list of vertices for top-down steps and as a bitmap for bottom-up steps. Both kinds of
+// step run in parallel: top-down claims a vertex with an atomic compare and swap of its parent, bottom-up gives each
+// thread whole 64 vertex words of the bitmaps, so no two threads write the same word.
+template <typename Weight>
+class BreadthFirstSearch {
+public:
+
+	// Switch to bottom-up when the edges out of the frontier are more than 1 / ALPHA of the edges into unreached vertices
+	static const int ALPHA = 14;
+
+	// Switch back to top-down when the frontier is smaller than 1 / BETA of the vertices
+	static const int BETA = 24;
+
+	// @ adjacency_list: the graph to search; copied into flat arrays of its edges and of its reversed edges
+	// @ pool: threads to run the steps on
+	BreadthFirstSearch(const vector<Vertex<int, Weight>>& adjacency_list, ThreadPool& pool)
+		: out_edges(adjacency_list, false), in_edges(adjacency_list, true), pool(pool),
+		parent_(adjacency_list.size()), hops_(adjacency_list.size(), -1)
+	{
+	}
+
+	// @ starting_vertex: ID of the vertex to search from
+	// Finds the hops and a path of fewest hops to every vertex. Returns the work done.
+	BFSStats run(int starting_vertex)
+	{
+		STATS_PHASE(bfs_timer, "bfs");
+		const int n = vertex_count();
+		const size_t words = (n + 63) / 64;
+		for (int v = 0; v < n; v++) {
+			parent_[v].store(NO_VERTEX, memory_order_relaxed);
+		}
+		fill(hops_.begin(), hops_.end(), -1);
+
+		BFSStats stats = { 0, 0, 0, 1 };
+		parent_[starting_vertex].store(starting_vertex, memory_order_relaxed);
+		hops_[starting_vertex] = 0;
+
+		vector<int> frontier(1, starting_vertex);
+		vector<uint64_t> frontier_bits(words, 0), next_bits(words, 0);
+		bool bottom_up = false;
+		size_t frontier_size = 1;
+
+		// Edges into vertices not reached yet; the edges a bottom-up step may have to look at
+		size_t unexplored_edges = in_edges.first[n] - in_degree(starting_vertex);
+
+		while (frontier_size > 0) {
+			const int level = stats.levels + 1;
+			if (!bottom_up) {
+				size_t frontier_edges = 0;
+				for (size_t i = 0; i < frontier.size(); i++) {
+					frontier_edges += out_edges.first[frontier[i] + 1] - out_edges.first[frontier[i]];
+				}
+				if (frontier_edges > unexplored_edges / ALPHA) {
+					bottom_up = true;
+					fill(frontier_bits.begin(), frontier_bits.end(), 0);
+					for (size_t i = 0; i < frontier.size(); i++) {
+						frontier_bits[frontier[i] / 64] |= uint64_t(1) << (frontier[i] % 64);
+					}
+				}
+			}
+			else if (frontier_size < static_cast<size_t>(n / BETA)) {
+				bottom_up = false;
+				frontier.clear();
+				for (int v = 0; v < n; v++) {
+					if ((frontier_bits[v / 64] >> (v % 64)) & 1) {
+						frontier.push_back(v);
+					}
+				}
+			}
+
+			size_t reached_edges = 0;
+			if (bottom_up) {
+				frontier_size = bottom_up_step(level, frontier_bits, next_bits, reached_edges);
+				frontier_bits.swap(next_bits);
+				stats.bottom_up_steps++;
+			}
+			else {
+				top_down_step(level, frontier);
+				frontier_size = frontier.size();
+				for (size_t i = 0; i < frontier.size(); i++) {
+					reached_edges += in_degree(frontier[i]);
+				}
+				stats.top_down_steps++;
+			}
+			unexplored_edges -= reached_edges;
+			stats.vertices_reached += frontier_size;
+			if (frontier_size > 0) {
+				stats.levels++;
+			}
+		}
+		return stats;
+	}
+
+	int vertex_count() const
+	{
+		return out_edges.vertex_count();
+	}
+
+	// Returns the number of hops from the starting vertex to v, or -1 if v cannot be reached
+	int hops(int v) const
+	{
+		return hops_[v];
+	}
+
+	// Returns the vertex before v on a path of fewest hops, or NO_VERTEX for the starting vertex and unreached vertices
+	int path(int v) const
+	{
+		int previous = parent_[v].load(memory_order_relaxed);
+		return previous == v ? NO_VERTEX : previous;
+	}
+
+private:
+	EdgeArrays<Weight> out_edges, in_edges;
+	ThreadPool& pool;
+
+	// parent_[v] is the vertex v was reached from (the starting vertex is its own parent), or NO_VERTEX
+	vector<atomic<int>> parent_;
+	vector<int> hops_;
+
+	// Vertices found by each thread in the current top-down step
+	vector<vector<int>> found;
+
+	// @ level: hops of the vertices this step finds
+	// @ frontier: the vertices found by the last step; replaced by the vertices this step finds
+	void top_down_step(int level, vector<int>& frontier)
+	{
+		found.resize(pool.size());
+		for (size_t t = 0; t < found.size(); t++) {
+			found[t].clear();
+		}
+		const size_t chunk = 256;
+		pool.parallel_for((frontier.size() + chunk - 1) / chunk, [&](size_t task, int thread) {
+			const size_t end = min(frontier.size(), (task + 1) * chunk);
+			for (size_t i = task * chunk; i < end; i++) {
+				const int u = frontier[i];
+				for (size_t e = out_edges.first[u]; e < out_edges.first[u + 1]; e++) {
+					const int v = out_edges.head[e];
+					int unreached = NO_VERTEX;
+					if (parent_[v].load(memory_order_relaxed) == NO_VERTEX
+						&& parent_[v].compare_exchange_strong(unreached, u, memory_order_relaxed)) {
+						hops_[v] = level;
+						found[thread].push_back(v);
+					}
+				}
+			}
+		});
+		frontier.clear();
+		for (size_t t = 0; t < found.size(); t++) {
+			frontier.insert(frontier.end(), found[t].begin(), found[t].end());
+		}
+	}
+
+	// Returns the number of edges into v
+	size_t in_degree(int v) const
+	{
+		return in_edges.first[v + 1] - in_edges.first[v];
+	}
+
+	// @ level: hops of the vertices this step finds
+	// @ frontier_bits: bitmap of the vertices found by the last step
+	// @ next_bits: receives the bitmap of the vertices this step finds
+	// @ reached_edges: receives the number of edges into the vertices this step finds
+	// Returns the number of vertices this step finds
+	size_t bottom_up_step(int level, const vector<uint64_t>& frontier_bits, vector<uint64_t>& next_bits, size_t& reached_edges)
+	{
+		const int n = vertex_count();
+		const size_t words_per_task = 64;
+		const size_t tasks = (frontier_bits.size() + words_per_task - 1) / words_per_task;
+		vector<size_t> counts(tasks, 0), edges(tasks, 0);
+		pool.parallel_for(tasks, [&](size_t task, int) {
+			const size_t end_word = min(frontier_bits.size(), (task + 1) * words_per_task);
+			for (size_t w = task * words_per_task; w < end_word; w++) {
+				uint64_t bits = 0;
+				const int last = min<int>(n, (w + 1) * 64);
+				for (int v = w * 64; v < last; v++) {
+					if (parent_[v].load(memory_order_relaxed) != NO_VERTEX) {
+						continue;
+					}
+					for (size_t e = in_edges.first[v]; e < in_edges.first[v + 1]; e++) {
+						const int u = in_edges.head[e];
+						if ((frontier_bits[u / 64] >> (u % 64)) & 1) {
+							parent_[v].store(u, memory_order_relaxed);
+							hops_[v] = level;
+							bits |= uint64_t(1) << (v % 64);
+							counts[task]++;
+							edges[task] += in_degree(v);
+							break;
+						}
+					}
+				}
+				next_bits[w] = bits;
+			}
+		});
+		size_t total = 0;
+		reached_edges = 0;
+		for (size_t t = 0; t < tasks; t++) {
+			total += counts[t];
+			reached_edges += edges[t];
+		}
+		return total;
+	}
+};
+
+// @ search: a finished search
+// @ names: labels of the vertices in the graph
+// @ output_order: IDs of the vertices in the order they should be printed
+// Prints a path of fewest hops to every vertex and its number of hops, or inf if it cannot be reached
+template <typename Weight>
+void printHops(const BreadthFirstSearch<Weight>& search, const NameTable& names, const vector<int>& output_order)
+{
+	STATS_PHASE(output_timer, "output");
+	vector<int> path;
+	for (size_t i = 0; i < output_order.size(); i++) {
+		const int v = output_order[i];
+		path.clear();
+		for (int u = v; u != NO_VERTEX; u = search.path(u)) {
+			path.push_back(u);
+		}
+		cout << names.name(v) << ": ";
+		for (size_t j = path.size(); j > 0; j--) {
+			cout << names.name(path[j - 1]) << (j > 1 ? ", " : "");
+		}
+		if (search.hops(v) < 0) {
+			cout << " (Hops: inf)" << endl;
+		}
+		else {
+			cout << " (Hops: " << search.hops(v) << ")" << endl;
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,244 @@
+/*
+	Author: Vishnu Rampersaud
+	Centrality.h header file
+	Betweenness centrality: how many shortest paths between other vertices go through each vertex, found
+	exactly or estimated from a sample of the sources, in parallel
+*/
+#ifndef CENTRALITY_H
+#define CENTRALITY_H
+
+#include "Vertex.h"
+#include "NameTable.h"
+#include "WeightTraits.h"
+#include "SearchWorkspace.h"
+#include "EdgeArrays.h"
+#include "ThreadPool.h"
+#include "Stats.h"
+#include <iostream>
+#include <vector>
+#include <random>
+#include <cmath>
+#include <algorithm>
+#include <utility>
+using namespace std;
+
+// Search state of one thread, reused for every source it searches from
+template <typename Weight>
+struct BrandesBuffer {
+	SearchWorkspace<Weight> workspace;
+
+	// Number of shortest paths from the source to each vertex, and each vertex's dependency on the source
+	vector<double> paths;
+	vector<double> dependency;
+
+	// settled_rank[v] is the position of v in settled, or -1 if the search has not settled it
+	vector<int> settled_rank;
+	vector<int> settled;
+
+	// Sum of the dependencies of each vertex over the sources this thread searched from
+	vector<double> score;
+
+	explicit BrandesBuffer(int vertices = 0)
+		: workspace(vertices), paths(vertices, 0), dependency(vertices, 0), settled_rank(vertices, -1), score(vertices, 0)
+	{
+	}
+};
+
+// Betweenness class
+// Brandes' algorithm: a Dijkstra search from a source s counts the shortest paths from s to every vertex, then
+// the vertices are taken in the opposite order they were settled in, and each passes its dependency on s to the
+// vertices before it on its shortest paths, in proportion to their numbers of paths:
+//     dependency(v) += paths(v) / paths(w) * (1 + dependency(w))
+// The betweenness of v is the sum of its dependencies over all sources. The vertices before w are found from the
+// edges into w; v is one if it was settled before w and its distance plus the edge weight is w's distance.
+//
+// The sources are searched in parallel. Each thread has its own buffers and sums its own scores, which are added
+// together at the end, so the threads never write the same memory.
+//
+// With a sample of k sources chosen at random, the sums are scaled by n / k. Each source adds between 0 and n - 2 to
+// a vertex's score, so by Hoeffding's inequality and a union bound over the vertices, with probability 1 - delta
+// every normalized score (divided by (n - 1)(n - 2)) is within sqrt(ln(2n / delta) / 2k) of the exact one.
+template <typename Weight>
+class Betweenness {
+public:
+
+	// Confidence of error_bound()
+	static constexpr double CONFIDENCE = 0.95;
+
+	// @ adjacency_list: the graph; copied into flat arrays of its edges and of its reversed edges
+	// @ pool: threads to search from the sources on
+	Betweenness(const vector<Vertex<int, Weight>>& adjacency_list, ThreadPool& pool)
+		: out_edges(adjacency_list, false), in_edges(adjacency_list, true), pool(pool), score_(adjacency_list.size(), 0), sources_(0)
+	{
+	}
+
+	// @ samples: number of sources to search from, chosen at random; 0, or at least the number of vertices, for all of them
+	// @ seed: seed of the random choice
+	// Finds the betweenness of every vertex, or an estimate from the samples. Returns the number of sources searched from.
+	int run(int samples, unsigned seed = 1)
+	{
+		STATS_PHASE(betweenness_timer, "betweenness");
+		const int n = vertex_count();
+		vector<int> sources(n);
+		for (int v = 0; v < n; v++) {
+			sources[v] = v;
+		}
+		if (samples > 0 && samples < n) {
+			mt19937 random(seed);
+			for (int i = 0; i < samples; i++) {
+				swap(sources[i], sources[i + random() % (n - i)]);
+			}
+			sources.resize(samples);
+		}
+		sources_ = sources.size();
+
+		vector<BrandesBuffer<Weight>> buffers(pool.size(), BrandesBuffer<Weight>(n));
+		pool.parallel_for(sources.size(), [&](size_t task, int thread) {
+			accumulate(sources[task], buffers[thread]);
+		});
+
+		const double scale = sources_ > 0 ? double(n) / sources_ : 0;
+		fill(score_.begin(), score_.end(), 0);
+		for (size_t t = 0; t < buffers.size(); t++) {
+			for (int v = 0; v < n; v++) {
+				score_[v] += buffers[t].score[v];
+			}
+		}
+		for (int v = 0; v < n; v++) {
+			score_[v] *= scale;
+		}
+		return sources_;
+	}
+
+	int vertex_count() const
+	{
+		return out_edges.vertex_count();
+	}
+
+	// Returns the number of shortest paths between other vertices that go through v (or the estimate of it),
+	// where a pair with several shortest paths counts the share of them through v
+	double score(int v) const
+	{
+		return score_[v];
+	}
+
+	// Returns the score of v divided by the number of pairs of other vertices, from 0 to 1
+	double normalized(int v) const
+	{
+		const double n = vertex_count();
+		return n > 2 ? score_[v] / ((n - 1) * (n - 2)) : 0;
+	}
+
+	// Returns true if every vertex was a source, so the scores are exact
+	bool exact() const
+	{
+		return sources_ == vertex_count();
+	}
+
+	// Returns how far from the exact one every normalized score is, with probability CONFIDENCE (0 if exact)
+	double error_bound() const
+	{
+		const double n = vertex_count();
+		if (exact() || sources_ == 0) {
+			return exact() ? 0 : 1;
+		}
+		return n / (n - 1) * sqrt(log(2 * n / (1 - CONFIDENCE)) / (2 * sources_));
+	}
+
+private:
+	EdgeArrays<Weight> out_edges, in_edges;
+	ThreadPool& pool;
+	vector<double> score_;
+	int sources_;
+
+	// Adds the dependencies of every vertex on source to the buffer's scores
+	void accumulate(int source, BrandesBuffer<Weight>& buffer)
+	{
+		SearchWorkspace<Weight>& workspace = buffer.workspace;
+		const Weight infinity = WeightTraits<Weight>::infinity();
+
+		// Count the shortest paths to each vertex as it is reached
+		workspace.improve(source, 0, NO_VERTEX);
+		buffer.paths[source] = 1;
+		QueueEntry<Weight> entry;
+		while (workspace.next(entry)) {
+			const int v = entry.id;
+			buffer.settled_rank[v] = buffer.settled.size();
+			buffer.settled.push_back(v);
+			for (size_t e = out_edges.first[v]; e < out_edges.first[v + 1]; e++) {
+				const int w = out_edges.head[e];
+				const Weight distance = WeightTraits<Weight>::add(entry.distance, out_edges.weight[e]);
+				if (workspace.improve(w, distance, v)) {
+					buffer.paths[w] = buffer.paths[v];
+				}
+				else if (distance == workspace.distance(w) && distance != infinity && buffer.settled_rank[w] < 0) {
+					buffer.paths[w] += buffer.paths[v];
+				}
+			}
+		}
+
+		// Pass the dependencies back, farthest vertex first
+		for (size_t i = buffer.settled.size(); i-- > 1; ) {
+			const int w = buffer.settled[i];
+			const double share = (1 + buffer.dependency[w]) / buffer.paths[w];
+			for (size_t e = in_edges.first[w]; e < in_edges.first[w + 1]; e++) {
+				const int v = in_edges.head[e];
+				const int rank = buffer.settled_rank[v];
+				if (rank >= 0 && rank < static_cast<int>(i)
+					&& WeightTraits<Weight>::add(workspace.distance(v), in_edges.weight[e]) == workspace.distance(w)) {
+					buffer.dependency[v] += buffer.paths[v] * share;
+				}
+			}
+			buffer.score[w] += buffer.dependency[w];
+		}
+
+		for (size_t i = 0; i < buffer.settled.size(); i++) {
+			const int v = buffer.settled[i];
+			buffer.paths[v] = 0;
+			buffer.dependency[v] = 0;
+			buffer.settled_rank[v] = -1;
+		}
+		buffer.settled.clear();
+		workspace.reset();
+	}
+};
+
+// @ centrality: scores found by Betweenness::run()
+// @ names: labels of the vertices in the graph
+// @ output_order: IDs of the vertices in the order they are printed, which breaks ties between equal scores
+// @ vertex: a vertex whose score and rank are printed after the list
+// @ top: number of vertices to list
+// Lists the vertices with the highest betweenness, then the score and rank of vertex
+template <typename Weight>
+void printBetweenness(const Betweenness<Weight>& centrality, const NameTable& names, const vector<int>& output_order, int vertex, int top)
+{
+	STATS_PHASE(output_timer, "output");
+	vector<pair<double, int>> ranking;
+	for (size_t i = 0; i < output_order.size(); i++) {
+		ranking.push_back(make_pair(-centrality.score(output_order[i]), i));
+	}
+	sort(ranking.begin(), ranking.end());
+
+	const int n = ranking.size();
+	if (centrality.exact()) {
+		cout << "Betweenness centrality from all " << n << " sources:" << endl;
+	}
+	else {
+		cout << "Betweenness centrality estimated from a sample of sources; with " << Betweenness<Weight>::CONFIDENCE * 100
+			<< "% confidence each normalized score is within " << centrality.error_bound() << " of the exact one:" << endl;
+	}
+	int rank = 0;
+	for (int r = 0; r < n; r++) {
+		const int v = output_order[ranking[r].second];
+		if (r < top) {
+			cout << r + 1 << ". " << names.name(v) << ": " << centrality.score(v) << " (Normalized: " << centrality.normalized(v) << ")" << endl;
+		}
+		if (v == vertex) {
+			rank = r + 1;
+		}
+	}
+	cout << "\nBetweenness of " << names.name(vertex) << ": " << centrality.score(vertex) << " (Normalized: "
+		<< centrality.normalized(vertex) << "), rank " << rank << " of " << n << endl;
+}
+
+#endif
@@ -0,0 +1,499 @@
+/*
+	Author: Vishnu Rampersaud
+	Components.h header file
+	Weakly and strongly connected components of a graph, found in parallel, and the O(1) reachability
+	answers they give
+*/
+#ifndef COMPONENTS_H
+#define COMPONENTS_H
+
+#include "Vertex.h"
+#include "NameTable.h"
+#include "EdgeArrays.h"
+#include "ThreadPool.h"
+#include "Stats.h"
+#include <iostream>
+#include <vector>
+#include <atomic>
+#include <algorithm>
+#include <chrono>
+using namespace std;
+
+// ConcurrentDisjointSets class
+// Union-find that many threads can use at once without locks. A root is linked under a smaller root with an
+// atomic compare and swap, which fails if another thread linked it first, and then the union is tried again.
+// Parents only ever get smaller, so there can be no cycles, and the root of a set is its smallest element.
+class ConcurrentDisjointSets {
+public:
+
+	// @ size: number of elements, each in its own set at first
+	explicit ConcurrentDisjointSets(int size) : parent(size)
+	{
+		for (int i = 0; i < size; i++) {
+			parent[i].store(i, memory_order_relaxed);
+		}
+	}
+
+	// Returns the root of the set of x, halving the path to it
+	// The halving is a compare and swap too; when it fails, another thread has already shortened the path
+	int find(int x)
+	{
+		while (true) {
+			int p = parent[x].load(memory_order_relaxed);
+			if (p == x) {
+				return x;
+			}
+			const int grandparent = parent[p].load(memory_order_relaxed);
+			if (grandparent != p) {
+				parent[x].compare_exchange_weak(p, grandparent, memory_order_relaxed);
+			}
+			x = grandparent;
+		}
+	}
+
+	// Joins the sets of x and y; returns false if they were already the same set
+	bool unite(int x, int y)
+	{
+		while (true) {
+			x = find(x);
+			y = find(y);
+			if (x == y) {
+				return false;
+			}
+			if (x < y) {
+				swap(x, y);
+			}
+			int root = x;
+			if (parent[x].compare_exchange_strong(root, y, memory_order_relaxed)) {
+				return true;
+			}
+		}
+	}
+
+private:
+	vector<atomic<int>> parent;
+};
+
+// What the components tell about a path from one vertex to another
+enum class Reachability { UNREACHABLE, REACHABLE, UNKNOWN };
+
+// Work done to find the strongly connected components
+struct ComponentStats {
+	size_t trimmed;
+	size_t pivot_component;
+	int coloring_rounds;
+	int propagation_passes;
+	double seconds;
+};
+
+// ComponentIndex class
+// The weakly connected component (ignoring edge directions) and strongly connected component of every vertex
+//
+// The weak components come from the lock-free union-find, with one union per edge, run in parallel.
+// The strong components are found in three steps (Slota, Rajamanickam and Madduri's Multistep method):
+//  - trim: a vertex with no edges in, or no edges out, is a component by itself
+//  - forward-backward: the vertices both reachable from and reaching a pivot of high degree are one component;
+//    in most graphs this is the one giant component, found with two parallel breadth first searches
+//  - coloring: every remaining vertex takes the largest vertex ID that can reach it, spread along the edges in
+//    parallel until nothing changes. Each vertex that kept its own ID is a root, and its component is the vertices
+//    of its color that reach it, found by a backward search per root; roots are searched in parallel since their
+//    colors do not overlap. Repeated on the vertices left over until every vertex has a component.
+// The strong components are then numbered in topological order of the condensation (the graph of the components),
+// so that an edge from u to v means strong(u) <= strong(v).
+//
+// reachability() answers in O(1): there is no path between different weak components, nor from a strong component
+// to an earlier one, and every vertex of a strong component reaches the others. Any other pair needs a search.
+class ComponentIndex {
+public:
+
+	// @ adjacency_list: the graph
+	// @ pool: threads to find the components on
+	template <typename Weight>
+	ComponentIndex(const vector<Vertex<int, Weight>>& adjacency_list, ThreadPool& pool)
+		: weak_(adjacency_list.size()), strong_(adjacency_list.size(), -1), weak_count_(0), strong_count_(0)
+	{
+		STATS_PHASE(components_timer, "components");
+		auto start = chrono::steady_clock::now();
+		EdgeArrays<Weight> out_edges(adjacency_list, false), in_edges(adjacency_list, true);
+		find_weak(out_edges, pool);
+
+		stats_.trimmed = 0;
+		stats_.pivot_component = 0;
+		stats_.coloring_rounds = 0;
+		stats_.propagation_passes = 0;
+		trim(out_edges, in_edges, pool);
+		forward_backward(out_edges, in_edges, pool);
+		color(out_edges, in_edges, pool);
+		number_strong(out_edges);
+		stats_.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+	}
+
+	int vertex_count() const
+	{
+		return weak_.size();
+	}
+
+	// Returns the weak component of v, from 0 to weak_count() - 1
+	int weak(int v) const
+	{
+		return weak_[v];
+	}
+
+	// Returns the strong component of v, from 0 to strong_count() - 1, in topological order
+	int strong(int v) const
+	{
+		return strong_[v];
+	}
+
+	int weak_count() const
+	{
+		return weak_count_;
+	}
+
+	int strong_count() const
+	{
+		return strong_count_;
+	}
+
+	// Returns the number of vertices in the largest weak (strong = false) or strong component
+	size_t largest(bool strong) const
+	{
+		const vector<int>& component = strong ? strong_ : weak_;
+		vector<size_t> sizes(strong ? strong_count_ : weak_count_, 0);
+		size_t most = 0;
+		for (size_t v = 0; v < component.size(); v++) {
+			most = max(most, ++sizes[component[v]]);
+		}
+		return most;
+	}
+
+	// Returns whether there is a path from the vertex from to the vertex to, as far as the components can tell
+	Reachability reachability(int from, int to) const
+	{
+		if (weak_[from] != weak_[to] || strong_[from] > strong_[to]) {
+			return Reachability::UNREACHABLE;
+		}
+		if (strong_[from] == strong_[to]) {
+			return Reachability::REACHABLE;
+		}
+		return Reachability::UNKNOWN;
+	}
+
+	const ComponentStats& stats() const
+	{
+		return stats_;
+	}
+
+private:
+	vector<int> weak_;
+
+	// Until number_strong(), a vertex's strong component is named by one of its vertices (-1 for none yet)
+	vector<int> strong_;
+	int weak_count_, strong_count_;
+	ComponentStats stats_;
+
+	// Vertices per task in the parallel loops over all vertices
+	static const size_t CHUNK = 1024;
+
+	static size_t chunks(size_t count)
+	{
+		return (count + CHUNK - 1) / CHUNK;
+	}
+
+	template <typename Weight>
+	void find_weak(const EdgeArrays<Weight>& out_edges, ThreadPool& pool)
+	{
+		const int n = out_edges.vertex_count();
+		ConcurrentDisjointSets sets(n);
+		pool.parallel_for(chunks(n), [&](size_t task, int) {
+			const int end = min<size_t>(n, (task + 1) * CHUNK);
+			for (int u = task * CHUNK; u < end; u++) {
+				for (size_t e = out_edges.first[u]; e < out_edges.first[u + 1]; e++) {
+					sets.unite(u, out_edges.head[e]);
+				}
+			}
+		});
+
+		// A root is the smallest vertex of its set, so it is numbered before the rest of the set
+		for (int v = 0; v < n; v++) {
+			const int root = sets.find(v);
+			weak_[v] = root == v ? weak_count_++ : weak_[root];
+		}
+	}
+
+	// Returns whether v has an edge to, or (with in_edges) from, another vertex without a component yet
+	template <typename Weight>
+	bool has_open_edge(const EdgeArrays<Weight>& edges, int v) const
+	{
+		for (size_t e = edges.first[v]; e < edges.first[v + 1]; e++) {
+			const int w = edges.head[e];
+			if (w != v && strong_[w] < 0) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	// Gives a component of their own to the vertices with no edges in or no edges out, for as long as that
+	// removes at least 1% of the vertices left in a pass
+	template <typename Weight>
+	void trim(const EdgeArrays<Weight>& out_edges, const EdgeArrays<Weight>& in_edges, ThreadPool& pool)
+	{
+		const int n = out_edges.vertex_count();
+		vector<vector<int>> trimmed(pool.size());
+		size_t remaining = n;
+		while (remaining > 0) {
+			pool.parallel_for(chunks(n), [&](size_t task, int thread) {
+				const int end = min<size_t>(n, (task + 1) * CHUNK);
+				for (int v = task * CHUNK; v < end; v++) {
+					if (strong_[v] < 0 && (!has_open_edge(out_edges, v) || !has_open_edge(in_edges, v))) {
+						trimmed[thread].push_back(v);
+					}
+				}
+			});
+
+			// The components are written after the pass, so no thread reads one while it is written
+			size_t count = 0;
+			for (size_t t = 0; t < trimmed.size(); t++) {
+				for (size_t i = 0; i < trimmed[t].size(); i++) {
+					strong_[trimmed[t][i]] = trimmed[t][i];
+				}
+				count += trimmed[t].size();
+				trimmed[t].clear();
+			}
+			stats_.trimmed += count;
+			remaining -= count;
+			if (count == 0 || count < remaining / 100) {
+				break;
+			}
+		}
+	}
+
+	// @ edges: the edges to follow
+	// @ start: vertex to search from
+	// @ reached: set to 1 for every vertex without a component yet that can be reached from start
+	template <typename Weight>
+	void reach(const EdgeArrays<Weight>& edges, int start, vector<atomic<char>>& reached, ThreadPool& pool) const
+	{
+		vector<vector<int>> found(pool.size());
+		vector<int> frontier(1, start);
+		reached[start].store(1, memory_order_relaxed);
+		const size_t chunk = 256;
+		while (!frontier.empty()) {
+			pool.parallel_for((frontier.size() + chunk - 1) / chunk, [&](size_t task, int thread) {
+				const size_t end = min(frontier.size(), (task + 1) * chunk);
+				for (size_t i = task * chunk; i < end; i++) {
+					const int u = frontier[i];
+					for (size_t e = edges.first[u]; e < edges.first[u + 1]; e++) {
+						const int w = edges.head[e];
+						if (strong_[w] < 0 && reached[w].load(memory_order_relaxed) == 0
+							&& reached[w].exchange(1, memory_order_relaxed) == 0) {
+							found[thread].push_back(w);
+						}
+					}
+				}
+			});
+			frontier.clear();
+			for (size_t t = 0; t < found.size(); t++) {
+				frontier.insert(frontier.end(), found[t].begin(), found[t].end());
+				found[t].clear();
+			}
+		}
+	}
+
+	// Finds the strong component of the vertex with the most edges in times edges out
+	template <typename Weight>
+	void forward_backward(const EdgeArrays<Weight>& out_edges, const EdgeArrays<Weight>& in_edges, ThreadPool& pool)
+	{
+		const int n = out_edges.vertex_count();
+		int pivot = NO_VERTEX;
+		double best = 0;
+		for (int v = 0; v < n; v++) {
+			const double degrees = double(out_edges.first[v + 1] - out_edges.first[v]) * (in_edges.first[v + 1] - in_edges.first[v]);
+			if (strong_[v] < 0 && (pivot == NO_VERTEX || degrees > best)) {
+				pivot = v;
+				best = degrees;
+			}
+		}
+		if (pivot == NO_VERTEX) {
+			return;
+		}
+
+		vector<atomic<char>> forward(n), backward(n);
+		pool.parallel_for(chunks(n), [&](size_t task, int) {
+			const int end = min<size_t>(n, (task + 1) * CHUNK);
+			for (int v = task * CHUNK; v < end; v++) {
+				forward[v].store(0, memory_order_relaxed);
+				backward[v].store(0, memory_order_relaxed);
+			}
+		});
+		reach(out_edges, pivot, forward, pool);
+		reach(in_edges, pivot, backward, pool);
+
+		vector<size_t> counts(chunks(n), 0);
+		pool.parallel_for(chunks(n), [&](size_t task, int) {
+			const int end = min<size_t>(n, (task + 1) * CHUNK);
+			for (int v = task * CHUNK; v < end; v++) {
+				if (forward[v].load(memory_order_relaxed) && backward[v].load(memory_order_relaxed)) {
+					strong_[v] = pivot;
+					counts[task]++;
+				}
+			}
+		});
+		for (size_t t = 0; t < counts.size(); t++) {
+			stats_.pivot_component += counts[t];
+		}
+	}
+
+	// Finds the strong components of the vertices left by the coloring rounds
+	template <typename Weight>
+	void color(const EdgeArrays<Weight>& out_edges, const EdgeArrays<Weight>& in_edges, ThreadPool& pool)
+	{
+		const int n = out_edges.vertex_count();
+		vector<atomic<int>> colors(n);
+		vector<int> remaining, roots;
+		vector<vector<int>> stacks(pool.size());
+		while (true) {
+			remaining.clear();
+			for (int v = 0; v < n; v++) {
+				colors[v].store(strong_[v] < 0 ? v : -1, memory_order_relaxed);
+				if (strong_[v] < 0) {
+					remaining.push_back(v);
+				}
+			}
+			if (remaining.empty()) {
+				return;
+			}
+			stats_.coloring_rounds++;
+
+			// Spread the largest color forward; a thread may see colors another thread has just raised,
+			// which only makes the spreading finish sooner
+			atomic<bool> changed(true);
+			while (changed.load()) {
+				changed.store(false);
+				stats_.propagation_passes++;
+				pool.parallel_for(chunks(remaining.size()), [&](size_t task, int) {
+					const size_t end = min(remaining.size(), (task + 1) * CHUNK);
+					for (size_t i = task * CHUNK; i < end; i++) {
+						const int u = remaining[i];
+						const int c = colors[u].load(memory_order_relaxed);
+						for (size_t e = out_edges.first[u]; e < out_edges.first[u + 1]; e++) {
+							const int w = out_edges.head[e];
+							if (strong_[w] >= 0) {
+								continue;
+							}
+							int old = colors[w].load(memory_order_relaxed);
+							while (old < c && !colors[w].compare_exchange_weak(old, c, memory_order_relaxed)) {
+							}
+							if (old < c) {
+								changed.store(true, memory_order_relaxed);
+							}
+						}
+					}
+				});
+			}
+
+			// The component of each root is the vertices of its color it can be reached from
+			roots.clear();
+			for (size_t i = 0; i < remaining.size(); i++) {
+				if (colors[remaining[i]].load(memory_order_relaxed) == remaining[i]) {
+					roots.push_back(remaining[i]);
+				}
+			}
+			pool.parallel_for(roots.size(), [&](size_t task, int thread) {
+				const int root = roots[task];
+				vector<int>& stack = stacks[thread];
+				strong_[root] = root;
+				stack.push_back(root);
+				while (!stack.empty()) {
+					const int u = stack.back();
+					stack.pop_back();
+					for (size_t e = in_edges.first[u]; e < in_edges.first[u + 1]; e++) {
+						const int w = in_edges.head[e];
+						if (colors[w].load(memory_order_relaxed) == root && strong_[w] < 0) {
+							strong_[w] = root;
+							stack.push_back(w);
+						}
+					}
+				}
+			});
+		}
+	}
+
+	// Renumbers the strong components in topological order of the condensation (Kahn's algorithm)
+	template <typename Weight>
+	void number_strong(const EdgeArrays<Weight>& out_edges)
+	{
+		const int n = out_edges.vertex_count();
+
+		// Number the components in vertex order first, and list the vertices of each one
+		vector<int> index(n, -1);
+		for (int v = 0; v < n; v++) {
+			if (strong_[v] == v) {
+				index[v] = strong_count_++;
+			}
+		}
+		vector<int> first(strong_count_ + 1, 0), members(n);
+		for (int v = 0; v < n; v++) {
+			first[index[strong_[v]] + 1]++;
+		}
+		for (int c = 0; c < strong_count_; c++) {
+			first[c + 1] += first[c];
+		}
+		vector<int> next(first.begin(), first.end() - 1);
+		vector<int> edges_in(strong_count_, 0);
+		for (int v = 0; v < n; v++) {
+			const int c = index[strong_[v]];
+			members[next[c]++] = v;
+			for (size_t e = out_edges.first[v]; e < out_edges.first[v + 1]; e++) {
+				if (index[strong_[out_edges.head[e]]] != c) {
+					edges_in[index[strong_[out_edges.head[e]]]]++;
+				}
+			}
+		}
+
+		// A component is numbered once every edge into it from another component has been passed
+		vector<int> order, ready;
+		order.reserve(strong_count_);
+		for (int c = strong_count_ - 1; c >= 0; c--) {
+			if (edges_in[c] == 0) {
+				ready.push_back(c);
+			}
+		}
+		vector<int> number(strong_count_);
+		while (!ready.empty()) {
+			const int c = ready.back();
+			ready.pop_back();
+			number[c] = order.size();
+			order.push_back(c);
+			for (int m = first[c]; m < first[c + 1]; m++) {
+				const int v = members[m];
+				for (size_t e = out_edges.first[v]; e < out_edges.first[v + 1]; e++) {
+					const int d = index[strong_[out_edges.head[e]]];
+					if (d != c && --edges_in[d] == 0) {
+						ready.push_back(d);
+					}
+				}
+			}
+		}
+		for (int v = 0; v < n; v++) {
+			strong_[v] = number[index[strong_[v]]];
+		}
+	}
+};
+
+// @ components: the components of a graph
+// @ out: where they are printed (standard output by default)
+// Prints the number of components of each kind and the size of the largest, then how they were found
+inline void printComponents(const ComponentIndex& components, ostream& out = cout)
+{
+	const ComponentStats& stats = components.stats();
+	out << "Components: " << components.weak_count() << " weakly connected (largest " << components.largest(false)
+		<< " vertices), " << components.strong_count() << " strongly connected (largest " << components.largest(true)
+		<< " vertices)" << endl;
+	out << "Strong components: " << stats.trimmed << " vertices trimmed, " << stats.pivot_component
+		<< " in the pivot's component, " << stats.coloring_rounds << " coloring rounds of " << stats.propagation_passes
+		<< " passes in total (" << stats.seconds * 1000 << " ms)" << endl;
+}
+
+#endif
@@ -0,0 +1,277 @@
+/*
+	Author: Vishnu Rampersaud
+	CompressedAdjacency.h header file
+	Compact storage for the adjacent vertices of a Vertex, and the iterator that reads them
+*/
+#ifndef COMPRESSED_ADJACENCY_H
+#define COMPRESSED_ADJACENCY_H
+
+#include "WeightTraits.h"
+#include <string>
+#include <vector>
+#include <utility>
+#include <cstring>
+#include <cstdint>
+#include <limits>
+#include <algorithm>
+using namespace std;
+
+// How the weights of a compressed adjacency list are stored
+// DOUBLE: 8 bytes per edge, exact
+// FLOAT: 4 bytes per edge, rounded to float precision
+// UINT16: 2 bytes per edge, quantized to 65536 levels between the lowest and highest weight of the vertex
+//
+// A compressed adjacency list is one byte array:
+//   [encoding][lowest weight and step (UINT16 only)][edge][edge]...
+// where each edge is the target ID as a variable length integer followed by the weight.
+// Weights of any weight type are converted to the stored form and back (see WeightTraits.h).
+// Target IDs are sorted; the first is stored as a zigzag coded difference from the vertex's own ID
+// and every other one as the difference from the previous target, so most take one or two bytes.
+enum class WeightEncoding : unsigned char { DOUBLE = 1, FLOAT = 2, UINT16 = 3 };
+
+// @ name: name of an encoding, as given on the command line
+// @ encoding: set to the encoding with this name
+// Returns false if there is no encoding with this name
+inline bool parse_weight_encoding(const string& name, WeightEncoding& encoding)
+{
+	if (name == "double") { encoding = WeightEncoding::DOUBLE; }
+	else if (name == "float") { encoding = WeightEncoding::FLOAT; }
+	else if (name == "uint16") { encoding = WeightEncoding::UINT16; }
+	else { return false; }
+	return true;
+}
+
+// Returns the name of an encoding
+inline const char* weight_encoding_name(WeightEncoding encoding)
+{
+	switch (encoding) {
+	case WeightEncoding::FLOAT: return "float";
+	case WeightEncoding::UINT16: return "uint16";
+	default: return "double";
+	}
+}
+
+// Appends value to bytes as a variable length integer; 7 bits per byte, high bit set on all but the last byte
+inline void write_varint(vector<unsigned char>& bytes, uint64_t value)
+{
+	while (value >= 0x80) {
+		bytes.push_back(static_cast<unsigned char>(value | 0x80));
+		value >>= 7;
+	}
+	bytes.push_back(static_cast<unsigned char>(value));
+}
+
+// Reads a variable length integer starting at bytes, and moves bytes past it
+inline uint64_t read_varint(const unsigned char*& bytes)
+{
+	uint64_t value = *bytes & 0x7f;
+	for (int shift = 7; *bytes++ & 0x80; shift += 7) {
+		value |= static_cast<uint64_t>(*bytes & 0x7f) << shift;
+	}
+	return value;
+}
+
+// Copies a value of type T to bytes without alignment requirements
+template <typename T>
+inline void write_raw(vector<unsigned char>& bytes, T value)
+{
+	unsigned char raw[sizeof(T)];
+	memcpy(raw, &value, sizeof(T));
+	bytes.insert(bytes.end(), raw, raw + sizeof(T));
+}
+
+// Reads a value of type T starting at bytes, and moves bytes past it
+template <typename T>
+inline T read_raw(const unsigned char*& bytes)
+{
+	T value;
+	memcpy(&value, bytes, sizeof(T));
+	bytes += sizeof(T);
+	return value;
+}
+
+// @ own_id: ID of the vertex the list belongs to
+// @ adjacent_vertices: the adjacent vertices and their weights; sorted by ID on return
+// @ encoding: how to store the weights
+// Returns the compressed form of the adjacency list
+template <typename Object, typename Weight>
+vector<unsigned char> compress_adjacency_list(Object own_id, vector<pair<Object, Weight>>& adjacent_vertices, WeightEncoding encoding)
+{
+	// Sort by ID so the differences between neighbors are small and non-negative
+	// Stable, so the first of several parallel edges stays first
+	stable_sort(adjacent_vertices.begin(), adjacent_vertices.end(),
+		[](const pair<Object, Weight>& a, const pair<Object, Weight>& b) { return a.first < b.first; });
+
+	vector<unsigned char> bytes;
+	bytes.reserve(1 + 8 + adjacent_vertices.size() * 4);
+	bytes.push_back(static_cast<unsigned char>(encoding));
+
+	float lowest = 0, step = 0;
+	if (encoding == WeightEncoding::UINT16 && !adjacent_vertices.empty()) {
+		double low = static_cast<double>(adjacent_vertices[0].second), high = low;
+		for (size_t i = 1; i < adjacent_vertices.size(); i++) {
+			low = min(low, static_cast<double>(adjacent_vertices[i].second));
+			high = max(high, static_cast<double>(adjacent_vertices[i].second));
+		}
+		lowest = static_cast<float>(low);
+		step = static_cast<float>((high - low) / numeric_limits<uint16_t>::max());
+	}
+	if (encoding == WeightEncoding::UINT16) {
+		write_raw(bytes, lowest);
+		write_raw(bytes, step);
+	}
+
+	int64_t previous = static_cast<int64_t>(own_id);
+	for (size_t i = 0; i < adjacent_vertices.size(); i++) {
+		int64_t id = static_cast<int64_t>(adjacent_vertices[i].first);
+		int64_t delta = id - previous;
+		if (i == 0) {
+			// Zigzag code the first difference, which may be negative
+			write_varint(bytes, (static_cast<uint64_t>(delta) << 1) ^ static_cast<uint64_t>(delta >> 63));
+		}
+		else {
+			write_varint(bytes, static_cast<uint64_t>(delta));
+		}
+		previous = id;
+
+		double weight = static_cast<double>(adjacent_vertices[i].second);
+		switch (encoding) {
+		case WeightEncoding::FLOAT:
+			write_raw(bytes, static_cast<float>(weight));
+			break;
+		case WeightEncoding::UINT16: {
+			double level = step > 0 ? (weight - lowest) / step + 0.5 : 0;
+			level = min(max(level, 0.0), static_cast<double>(numeric_limits<uint16_t>::max()));
+			write_raw(bytes, static_cast<uint16_t>(level));
+			break;
+		}
+		default:
+			write_raw(bytes, weight);
+			break;
+		}
+	}
+
+	bytes.shrink_to_fit();
+	return bytes;
+}
+
+// AdjacencyIterator class
+// Reads the adjacent vertices of a Vertex one edge at a time, whether they are stored
+// as a plain vector of pairs or in compressed form; dereferencing gives an (ID, weight) pair
+template <typename Object, typename Weight>
+class AdjacencyIterator {
+public:
+
+	// @ edge: pointer to an edge in a plain adjacency list
+	// Constructor for an uncompressed adjacency list
+	explicit AdjacencyIterator(const pair<Object, Weight>* edge)
+		: edge(edge), position(nullptr), next(nullptr), end(nullptr),
+		  encoding(WeightEncoding::DOUBLE), lowest(0), step(0), previous(0), current()
+	{
+	}
+
+	// @ position: the first edge to read, or end
+	// @ end: one past the last byte of the compressed list
+	// @ encoding, lowest, step: how the weights are stored
+	// @ previous: ID the first difference is taken from (the vertex's own ID)
+	// Constructor for a compressed adjacency list
+	AdjacencyIterator(const unsigned char* position, const unsigned char* end, WeightEncoding encoding,
+		float lowest, float step, int64_t previous)
+		: edge(nullptr), position(position), next(position), end(end),
+		  encoding(encoding), lowest(lowest), step(step), previous(previous), current()
+	{
+		if (position != end) {
+			decode(true);
+		}
+	}
+
+	// Returns the current edge as an (ID, weight) pair
+	pair<Object, Weight> operator*() const
+	{
+		return edge ? *edge : current;
+	}
+
+	// Moves to the next edge
+	AdjacencyIterator& operator++()
+	{
+		if (edge) {
+			++edge;
+		}
+		else {
+			position = next;
+			if (position != end) {
+				decode(false);
+			}
+		}
+		return *this;
+	}
+
+	bool operator==(const AdjacencyIterator& rhs) const
+	{
+		return edge == rhs.edge && position == rhs.position;
+	}
+
+	bool operator!=(const AdjacencyIterator& rhs) const
+	{
+		return !(*this == rhs);
+	}
+
+private:
+	// Current edge of an uncompressed list; nullptr for a compressed list
+	const pair<Object, Weight>* edge;
+
+	// Start of the current edge, start of the edge after it, and end of a compressed list
+	const unsigned char* position;
+	const unsigned char* next;
+	const unsigned char* end;
+
+	WeightEncoding encoding;
+	float lowest, step;
+
+	// ID of the edge before the current one
+	int64_t previous;
+
+	// The current edge of a compressed list, decoded
+	pair<Object, Weight> current;
+
+	// Decodes the edge at position into current, and sets next to the start of the following edge
+	void decode(bool first_edge)
+	{
+		const unsigned char* bytes = position;
+		uint64_t delta = read_varint(bytes);
+		if (first_edge) {
+			previous += static_cast<int64_t>(delta >> 1) ^ -static_cast<int64_t>(delta & 1);
+		}
+		else {
+			previous += static_cast<int64_t>(delta);
+		}
+		current.first = static_cast<Object>(previous);
+
+		switch (encoding) {
+		case WeightEncoding::FLOAT: current.second = WeightTraits<Weight>::from_double(read_raw<float>(bytes)); break;
+		case WeightEncoding::UINT16: current.second = WeightTraits<Weight>::from_double(lowest + step * read_raw<uint16_t>(bytes)); break;
+		default: current.second = WeightTraits<Weight>::from_double(read_raw<double>(bytes)); break;
+		}
+		next = bytes;
+	}
+};
+
+// AdjacencyRange class
+// The adjacent vertices of a Vertex; used with a range based for loop:
+//     for (auto edge : v.adjacent()) { ... edge.first ... edge.second ... }
+template <typename Object, typename Weight>
+class AdjacencyRange {
+public:
+	AdjacencyRange(const AdjacencyIterator<Object, Weight>& first, const AdjacencyIterator<Object, Weight>& last)
+		: first(first), last(last)
+	{
+	}
+
+	AdjacencyIterator<Object, Weight> begin() const { return first; }
+	AdjacencyIterator<Object, Weight> end() const { return last; }
+
+private:
+	AdjacencyIterator<Object, Weight> first, last;
+};
+
+#endif
@@ -0,0 +1,182 @@
+/*
+	Author: Vishnu Rampersaud
+	CreateGraphAndTest.h header file
+	Answers adjacency and reachability queries against the adjacency list of a graph
+*/
+#ifndef CREATE_GRAPH_AND_TEST_H
+#define CREATE_GRAPH_AND_TEST_H
+
+#include "Vertex.h"
+#include "NameTable.h"
+#include "Stats.h"
+#include "BreadthFirstSearch.h"
+#include "Components.h"
+#include "ThreadPool.h"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <utility>
+#include <map>
+using namespace std;
+
+// @ adjacenyQuery_filename: file that contains a list of edges
+// @ adjacency_list: adjacency list of a graph
+// @ names: labels of the vertices in the graph
+// @ out: where the results are written (standard output by default)
+// This function takes in a file (adjacencyQuery_filename) which has a list of edges (2 vertices) 
+// and tests whether these edges are present in an actual graph using the adjacency list of a graph
+template <typename Weight>
+void test_graph(const string& adjacencyQuery_filename, const vector<Vertex<int, Weight>>& adjacency_list, const NameTable& names,
+	ostream& out = cout)
+{
+	STATS_PHASE(query_timer, "test_graph");
+
+	// Open adjacency query test file; contains list of edges
+	ifstream adj_query; 
+	adj_query.open(adjacencyQuery_filename); 
+
+	string vertex_1, vertex_2; 
+	string line; 
+
+	// For each edge in the file, check whether it exists on the graph
+	// If it exists, output its weight
+	while (!adj_query.eof())
+	{
+		// Get edge from file 
+		getline(adj_query, line); 
+		if (line.empty()) { continue; }
+
+		// Store the two vertices of the edge in variables
+		stringstream ss(line); 
+		ss >> vertex_1 >> vertex_2; 
+		
+		// Checks to see if the first vertex is a part of the graph
+		// If the vertex is in the graph, get its ID so its data can be accessed 
+		int id_1 = names.find(vertex_1); 
+		if (id_1 == NO_VERTEX) {
+			out << vertex_1 << " " << vertex_2 << ": " << "Vertex " << vertex_1 << " not found" << endl;
+			continue; 
+		}
+
+		// A second vertex that is not in the graph cannot be adjacent to anything
+		int id_2 = names.find(vertex_2); 
+
+		// Check to see if vertex_2 of the test edge is adjacent to vertex_1 in the graph
+		// If it is, then this edge exists on the graph; Output its weight
+		bool connected = false; 
+		for (auto edge : adjacency_list[id_1].adjacent()) {
+			if (id_2 == edge.first) {
+				Weight weight = edge.second;
+				out << vertex_1 << " " << vertex_2 << ": Connected, weight of edge is " << weight << endl;
+				connected = true; 
+				break; 
+			}
+		}
+		if (!connected) {
+			out << vertex_1 << " " << vertex_2 << ": Not connected" << endl;
+		}
+		
+	}
+
+	// Close file
+	adj_query.close(); 
+}
+
+// @ query_filename: file that contains a list of vertex pairs
+// @ adjacency_list: adjacency list of a graph
+// @ names: labels of the vertices in the graph
+// @ threads: number of threads for the breadth first searches; 0 uses one per core
+// @ components: true to find the components of the graph first (see Components.h)
+// @ out: where the results are written (standard output by default)
+// Tests for each pair whether there is a path from the first vertex to the second, and prints the fewest edges
+// (hops) on such a path. One breadth first search is run per distinct first vertex, not one per query.
+// With the components, a pair they show has no path is answered without a search, and a first vertex
+// whose pairs all have such answers is not searched from at all.
+template <typename Weight>
+void test_reachability(const string& query_filename, const vector<Vertex<int, Weight>>& adjacency_list, const NameTable& names,
+	int threads, bool components, ostream& out = cout)
+{
+	STATS_PHASE(query_timer, "test_reachability");
+
+	// Read every query, and the queries that start at each vertex
+	ifstream query_file(query_filename);
+	vector<pair<string, string>> queries;
+	map<int, vector<size_t>> queries_from;
+	string line;
+	while (getline(query_file, line)) {
+		stringstream ss(line);
+		string vertex_1, vertex_2;
+		if (!(ss >> vertex_1 >> vertex_2)) {
+			continue;
+		}
+		queries.push_back(make_pair(vertex_1, vertex_2));
+		int id_1 = names.find(vertex_1);
+		if (id_1 != NO_VERTEX) {
+			queries_from[id_1].push_back(queries.size() - 1);
+		}
+	}
+
+	// Drop the queries the components answer
+	vector<int> hops(queries.size(), -1);
+	ThreadPool pool(threads);
+	size_t answered = 0;
+	if (components) {
+		ComponentIndex component_index(adjacency_list, pool);
+		printComponents(component_index, out);
+		out << endl;
+		for (auto start = queries_from.begin(); start != queries_from.end(); ) {
+			vector<size_t>& from = start->second;
+			for (size_t q = 0; q < from.size(); ) {
+				int id_2 = names.find(queries[from[q]].second);
+				if (id_2 == NO_VERTEX || component_index.reachability(start->first, id_2) == Reachability::UNREACHABLE) {
+					from[q] = from.back();
+					from.pop_back();
+					answered++;
+				}
+				else {
+					q++;
+				}
+			}
+			if (from.empty()) {
+				queries_from.erase(start++);
+			}
+			else {
+				++start;
+			}
+		}
+	}
+
+	// Answer the queries of each starting vertex from one search
+	BreadthFirstSearch<Weight> bfs(adjacency_list, pool);
+	for (auto start = queries_from.begin(); start != queries_from.end(); ++start) {
+		bfs.run(start->first);
+		for (size_t q = 0; q < start->second.size(); q++) {
+			int id_2 = names.find(queries[start->second[q]].second);
+			if (id_2 != NO_VERTEX) {
+				hops[start->second[q]] = bfs.hops(id_2);
+			}
+		}
+	}
+
+	for (size_t q = 0; q < queries.size(); q++) {
+		const string& vertex_1 = queries[q].first;
+		const string& vertex_2 = queries[q].second;
+		if (names.find(vertex_1) == NO_VERTEX) {
+			out << vertex_1 << " " << vertex_2 << ": " << "Vertex " << vertex_1 << " not found" << endl;
+		}
+		else if (hops[q] < 0) {
+			out << vertex_1 << " " << vertex_2 << ": Not reachable" << endl;
+		}
+		else {
+			out << vertex_1 << " " << vertex_2 << ": Reachable in " << hops[q] << (hops[q] == 1 ? " hop" : " hops") << endl;
+		}
+	}
+	if (components) {
+		out << "\n" << answered << " of " << queries.size() << " queries answered by the components, "
+			<< queries_from.size() << " breadth first searches" << endl;
+	}
+}
+
+#endif
@@ -0,0 +1,174 @@
+/*
+	Author: Vishnu Rampersaud
+	Computes the matrix of shortest path costs from a list of source vertices to a list of target vertices,
+	or between all pairs of vertices, and writes it as a CSV or binary file
+*/
+
+#include "AdjacencyList.h"
+#include "DistanceMatrix.h"
+#include "AllPairs.h"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cstdlib>
+#include <chrono>
+using namespace std;
+
+bool testFiles(const vector<string>& files)
+{
+	ifstream file;
+	for (size_t i = 0; i < files.size(); i++) {
+		file.open(files[i]);
+		if (file.is_open()) {
+			file.close();
+			continue;
+		}
+		else {
+			cout << files[i] << " does not exist in the current directory." << endl;
+			cout << "Program will terminate" << endl;
+			return false;
+		}
+	}
+
+	return true;
+}
+
+int main(int argc, char** argv)
+{
+	// Checks to see if the correct number of arguments are entered
+	const string usage = string("Usage: ") + argv[0] + " <GRAPH_FILE> <SOURCES_FILE> <TARGETS_FILE> <MATRIX_FILE>"
+		+ " [--format=csv|binary] [--threads=<THREADS>] [--stats[=<STATS_FILE>]]\n"
+		+ "       " + argv[0] + " <GRAPH_FILE> --all-pairs <MATRIX_FILE> [--method=auto|floyd|dijkstra]"
+		+ " [--format=csv|binary] [--threads=<THREADS>] [--stats[=<STATS_FILE>]]";
+	const bool every_pair = argc >= 4 && string(argv[2]) == "--all-pairs";
+	if (argc < 5 && !every_pair) {
+		cout << usage << endl;
+		return 0;
+	}
+
+	// Read the options that follow the required arguments
+	bool binary = false;
+	int threads = 0;
+	AllPairsMethod method = AllPairsMethod::AUTO;
+	string stats_destination;
+	for (int i = every_pair ? 4 : 5; i < argc; i++) {
+		const string option(argv[i]);
+		if (option.compare(0, 9, "--method=") == 0 && every_pair && parse_all_pairs_method(option.substr(9), method)) {
+			continue;
+		}
+		if (option == "--format=csv" || option == "--format=binary") {
+			binary = option == "--format=binary";
+			continue;
+		}
+		if (option.compare(0, 10, "--threads=") == 0 && atoi(option.c_str() + 10) >= 0) {
+			threads = atoi(option.c_str() + 10);
+			continue;
+		}
+		if (option == "--stats") {
+			stats_destination = "-";
+			continue;
+		}
+		if (option.compare(0, 8, "--stats=") == 0 && option.size() > 8) {
+			stats_destination = option.substr(8);
+			continue;
+		}
+		cout << "Unknown option: " << option << endl;
+		cout << usage << endl;
+		return 0;
+	}
+
+	// Store arguments into variables
+	const string graph_filename(argv[1]);
+	const string sources_filename(every_pair ? "" : argv[2]);
+	const string targets_filename(every_pair ? "" : argv[3]);
+	const string matrix_filename(argv[every_pair ? 3 : 4]);
+
+	// Test to see if files are valid; If they exist in the current directory
+	vector<string> files;
+	files.push_back(graph_filename);
+	if (!every_pair) {
+		files.push_back(sources_filename);
+		files.push_back(targets_filename);
+	}
+	if (!testFiles(files)) {
+		return 0;
+	}
+
+	// Display files that will be used
+	cout << "\nInput Graph file: " << graph_filename;
+	if (!every_pair) {
+		cout << "\nInput Sources file: " << sources_filename << "\nInput Targets file: " << targets_filename;
+	}
+	cout << "\n" << endl;
+
+	// Create empty vector to store adjacency list, and a table for the vertex labels
+	vector<Vertex<int, weight_type>> adjacency_list;
+	NameTable names;
+
+	// Create adjacency list to represent the input graph
+	if (!createAdjacencyList(graph_filename, adjacency_list, names)) {
+		cout << "Program will terminate" << endl;
+		return 0;
+	}
+
+	// Find the IDs of the sources and targets; every vertex, in ID order, for all pairs
+	vector<int> sources, targets;
+	vector<string> source_labels, target_labels;
+	if (every_pair) {
+		for (size_t v = 0; v < adjacency_list.size(); v++) {
+			sources.push_back(v);
+			source_labels.push_back(names.name(v));
+		}
+		targets = sources;
+		target_labels = source_labels;
+	}
+	else if (!read_vertex_list(sources_filename, names, sources, source_labels)
+		|| !read_vertex_list(targets_filename, names, targets, target_labels)) {
+		return 0;
+	}
+
+	// Compute the matrix
+	ThreadPool pool(threads);
+	vector<weight_type> matrix;
+	MatrixStats stats = { 0, false, 0, 0 };
+	auto start_time = chrono::steady_clock::now();
+	if (every_pair) {
+		method = all_pairs(adjacency_list, pool, method, matrix);
+	}
+	else {
+		stats = distance_matrix(adjacency_list, sources, targets, pool, matrix);
+	}
+	const double seconds = chrono::duration<double>(chrono::steady_clock::now() - start_time).count();
+
+	// Write the matrix
+	STATS_PHASE(output_timer, "output");
+	ofstream matrix_file(matrix_filename, binary ? ios::out | ios::binary : ios::out);
+	if (binary) {
+		write_matrix_binary(matrix_file, sources.size(), targets.size(), matrix);
+	}
+	else {
+		write_matrix_csv(matrix_file, source_labels, target_labels, matrix);
+	}
+	matrix_file.close();
+	STATS_STOP(output_timer);
+	if (!matrix_file) {
+		cout << "Could not write " << matrix_filename << endl;
+		return 0;
+	}
+
+	cout << sources.size() << " x " << targets.size() << " matrix written to " << matrix_filename << endl;
+	if (every_pair) {
+		cout << "All pairs by " << (method == AllPairsMethod::FLOYD_WARSHALL ? "blocked Floyd-Warshall" : "repeated Dijkstra")
+			<< (method == AllPairsMethod::FLOYD_WARSHALL && cpu_has_avx2() ? " (AVX2)" : "") << " on " << pool.size()
+			<< " threads, " << seconds * 1000 << " ms" << endl;
+	}
+	else {
+		cout << stats.searches << (stats.backward ? " backward" : " forward") << " searches on " << pool.size() << " threads, "
+			<< stats.vertices_settled << " vertices settled, " << stats.seconds * 1000 << " ms" << endl;
+	}
+
+	// Print the phase times and counters if they were asked for
+	report_stats(stats_destination, "DistanceMatrix");
+	return 0;
+}
@@ -0,0 +1,183 @@
+/*
+	Author: Vishnu Rampersaud
+	DistanceMatrix.h header file
+	Computes the costs of the shortest paths from a list of sources to a list of targets, with the searches
+	spread over a thread pool, and writes them as a CSV or binary matrix
+*/
+#ifndef DISTANCE_MATRIX_H
+#define DISTANCE_MATRIX_H
+
+#include "Vertex.h"
+#include "EdgeArrays.h"
+#include "NameTable.h"
+#include "WeightTraits.h"
+#include "SearchWorkspace.h"
+#include "ThreadPool.h"
+#include "Stats.h"
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+using namespace std;
+
+// Work done for one matrix
+struct MatrixStats {
+	size_t searches;
+	bool backward;
+	unsigned long long vertices_settled;
+	double seconds;
+};
+
+// @ edges: the graph to search
+// @ workspace: search state sized for the graph; reset here, and holds the costs afterwards
+// @ start: ID of the vertex to search from
+// @ wanted: wanted[v] is true for the vertices whose cost is needed
+// @ wanted_count: number of vertices with wanted[v] true
+// Dijkstra's algorithm that stops as soon as every wanted vertex is settled
+// Returns the number of vertices settled
+template <typename Weight>
+size_t search_until_settled(const EdgeArrays<Weight>& edges, SearchWorkspace<Weight>& workspace, int start,
+	const vector<char>& wanted, size_t wanted_count)
+{
+	workspace.reset();
+	workspace.improve(start, 0, NO_VERTEX);
+
+	QueueEntry<Weight> top;
+	size_t settled = 0;
+	while (wanted_count > 0 && workspace.next(top)) {
+		settled++;
+		if (wanted[top.id]) {
+			wanted_count--;
+		}
+		for (size_t e = edges.first[top.id]; e < edges.first[top.id + 1]; e++) {
+			workspace.improve(edges.head[e], WeightTraits<Weight>::add(top.distance, edges.weight[e]), top.id);
+		}
+	}
+	return settled;
+}
+
+// @ adjacency_list: the graph
+// @ sources: IDs of the rows of the matrix
+// @ targets: IDs of the columns of the matrix
+// @ pool: threads to run the searches on
+// @ matrix: receives sources.size() rows of targets.size() costs, row after row; infinity where there is no path
+// Runs one search per source on the graph, or, when there are fewer targets than sources, one search per
+// target on the reversed graph, whose costs are the costs to that target. Each search stops once it has settled
+// every vertex of the other list. Returns the work done.
+template <typename Weight>
+MatrixStats distance_matrix(const vector<Vertex<int, Weight>>& adjacency_list, const vector<int>& sources,
+	const vector<int>& targets, ThreadPool& pool, vector<Weight>& matrix)
+{
+	STATS_PHASE(matrix_timer, "distance_matrix");
+	auto start_time = chrono::steady_clock::now();
+	const size_t rows = sources.size(), columns = targets.size();
+	matrix.assign(rows * columns, WeightTraits<Weight>::infinity());
+
+	MatrixStats stats = { 0, columns < rows, 0, 0 };
+	const vector<int>& starts = stats.backward ? targets : sources;
+	const vector<int>& ends = stats.backward ? sources : targets;
+	stats.searches = starts.size();
+
+	EdgeArrays<Weight> edges(adjacency_list, stats.backward);
+	vector<char> wanted(edges.vertex_count(), 0);
+	size_t wanted_count = 0;
+	for (size_t i = 0; i < ends.size(); i++) {
+		if (!wanted[ends[i]]) {
+			wanted[ends[i]] = 1;
+			wanted_count++;
+		}
+	}
+
+	vector<SearchWorkspace<Weight>> workspaces;
+	for (int t = 0; t < pool.size(); t++) {
+		workspaces.push_back(SearchWorkspace<Weight>(edges.vertex_count()));
+	}
+	vector<unsigned long long> settled(pool.size(), 0);
+
+	// Each search fills one row, or one column when searching backward, so no two threads write the same entry
+	pool.parallel_for(starts.size(), [&](size_t s, int thread) {
+		SearchWorkspace<Weight>& workspace = workspaces[thread];
+		settled[thread] += search_until_settled(edges, workspace, starts[s], wanted, wanted_count);
+		for (size_t e = 0; e < ends.size(); e++) {
+			Weight cost = workspace.distance(ends[e]);
+			matrix[stats.backward ? e * columns + s : s * columns + e] = cost;
+		}
+	});
+
+	for (size_t t = 0; t < settled.size(); t++) {
+		stats.vertices_settled += settled[t];
+	}
+	stats.seconds = chrono::duration<double>(chrono::steady_clock::now() - start_time).count();
+	return stats;
+}
+
+// @ filename: file of vertex labels separated by whitespace
+// @ names: labels of the vertices in the graph
+// @ ids: receives the IDs of the vertices, in file order
+// @ labels: receives the labels, in file order
+// Returns false, after printing the label, if a label is not a vertex of the graph
+inline bool read_vertex_list(const string& filename, const NameTable& names, vector<int>& ids, vector<string>& labels)
+{
+	ifstream file(filename);
+	string label;
+	while (file >> label) {
+		int id = names.find(label);
+		if (id == NO_VERTEX) {
+			cout << "Vertex " << label << " in " << filename << " is not in the graph" << endl;
+			return false;
+		}
+		ids.push_back(id);
+		labels.push_back(label);
+	}
+	return true;
+}
+
+// @ out: stream to write to
+// @ row_labels, column_labels: labels of the sources and targets
+// @ matrix: costs, row after row
+// Writes a header line of the target labels, then one line per source: its label and its costs,
+// with "inf" where there is no path
+template <typename Weight>
+void write_matrix_csv(ostream& out, const vector<string>& row_labels, const vector<string>& column_labels, const vector<Weight>& matrix)
+{
+	out << "source";
+	for (size_t c = 0; c < column_labels.size(); c++) {
+		out << "," << column_labels[c];
+	}
+	out << "\n";
+	for (size_t r = 0; r < row_labels.size(); r++) {
+		out << row_labels[r];
+		for (size_t c = 0; c < column_labels.size(); c++) {
+			Weight cost = matrix[r * column_labels.size() + c];
+			out << ",";
+			if (cost == WeightTraits<Weight>::infinity()) {
+				out << "inf";
+			}
+			else {
+				out << cost;
+			}
+		}
+		out << "\n";
+	}
+}
+
+// @ out: binary stream to write to
+// @ rows, columns: size of the matrix
+// @ matrix: costs, row after row
+// Writes the magic "GDM1", the number of rows, the number of columns and the size of a cost in bytes
+// (each a 4 byte unsigned integer in the machine's byte order), then the costs row after row as raw values
+// of the weight type; infinity is WeightTraits<Weight>::infinity()
+template <typename Weight>
+void write_matrix_binary(ostream& out, uint32_t rows, uint32_t columns, const vector<Weight>& matrix)
+{
+	const uint32_t weight_size = sizeof(Weight);
+	out.write("GDM1", 4);
+	out.write(reinterpret_cast<const char*>(&rows), sizeof(rows));
+	out.write(reinterpret_cast<const char*>(&columns), sizeof(columns));
+	out.write(reinterpret_cast<const char*>(&weight_size), sizeof(weight_size));
+	out.write(reinterpret_cast<const char*>(matrix.data()), matrix.size() * sizeof(Weight));
+}
+
+#endif
@@ -0,0 +1,364 @@
+/*
+	Author: Vishnu Rampersaud
+	DynamicPaths.h header file
+	Keeps the shortest paths found by dijkstra() up to date while edges are inserted, deleted or reweighted
+*/
+#ifndef DYNAMIC_PATHS_H
+#define DYNAMIC_PATHS_H
+
+#include "Vertex.h"
+#include "NameTable.h"
+#include "WeightTraits.h"
+#include "FindPaths.h"
+#include "Stats.h"
+#include "binary_heap.h"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <utility>
+using namespace std;
+
+// Kinds of edge changes in an update batch
+// INSERT: add an edge, or change its weight if the edge is already there
+// DELETE: remove an edge
+// CHANGE: change the weight of an edge that is already there
+enum class EdgeChangeKind { INSERT, DELETE, CHANGE };
+
+// One change to an edge of the graph
+template <typename Weight>
+struct EdgeChange {
+	EdgeChangeKind kind;
+	int from, to;
+	Weight weight;
+};
+
+// Counters from the repair after one batch of edge changes
+struct UpdateStats {
+	// Changes in the batch that were applied to the graph
+	size_t edges_changed;
+	// Vertices whose shortest path went through an edge that was deleted or made heavier
+	size_t vertices_affected;
+	// Vertices whose cost or path is different after the batch
+	size_t vertices_updated;
+	double milliseconds;
+};
+
+// DynamicPaths class
+// Repairs the costs and paths that dijkstra() stored in the adjacency list after a batch of edge changes,
+// in the style of Ramalingam and Reps' dynamic shortest path algorithm. Only the part of the shortest
+// path tree that the changes can affect is visited; everything else keeps its cost and path.
+//
+// 1. Every vertex whose tree edge (the edge from its path vertex) was deleted or made heavier loses its
+//    cost, together with the subtree of the shortest path tree below it: the affected vertices.
+//    The tree is not stored; the children of a vertex are the adjacent vertices whose path is that vertex.
+// 2. Each affected vertex gets the best cost it can reach through an edge from an unaffected vertex,
+//    which needs the incoming edges of each vertex; these are kept here and changed along with the graph.
+// 3. Edges that were inserted or made lighter are relaxed.
+// 4. Every vertex whose cost went down in steps 2 and 3 is put in a priority queue, and the lower costs
+//    are spread through the graph as in Dijkstra's algorithm, only as far as they make a difference.
+template <typename Weight>
+class DynamicPaths {
+public:
+
+	// @ adjacency_list: a graph on which dijkstra() has been run
+	// @ starting_vertex: ID of the vertex dijkstra() started from
+	// Constructor that builds the incoming edges of every vertex
+	DynamicPaths(vector<Vertex<int, Weight>>& adjacency_list, int starting_vertex)
+		: adjacency_list(adjacency_list), starting_vertex(starting_vertex),
+		  incoming(adjacency_list.size()), affected(adjacency_list.size(), false), changed(adjacency_list.size(), false)
+	{
+		for (size_t v = 0; v < adjacency_list.size(); v++) {
+			for (auto edge : adjacency_list[v].adjacent()) {
+				incoming[edge.first].push_back(make_pair(static_cast<int>(v), edge.second));
+			}
+		}
+	}
+
+	// @ batch: the edge changes to make, in order
+	// Changes the graph and repairs the costs and paths of the vertices
+	// Returns the number of changes made and of vertices affected and updated
+	UpdateStats apply_batch(const vector<EdgeChange<Weight>>& batch)
+	{
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		UpdateStats stats = { 0, 0, 0, 0 };
+		const Weight infinity = WeightTraits<Weight>::infinity();
+
+		// Change the graph, and remember where the repair has to start
+		vector<int> affected_roots, lighter_edges;
+		for (size_t i = 0; i < batch.size(); i++) {
+			const EdgeChange<Weight>& change = batch[i];
+			Weight old_weight = 0;
+			const bool had_edge = find_weight(change.from, change.to, old_weight);
+
+			if (change.kind == EdgeChangeKind::DELETE || change.kind == EdgeChangeKind::CHANGE) {
+				if (!had_edge) { continue; }
+			}
+			if (change.kind == EdgeChangeKind::DELETE) {
+				adjacency_list[change.from].remove_adjacent_vertex(change.to);
+				remove_incoming(change.from, change.to);
+			}
+			else if (had_edge) {
+				adjacency_list[change.from].set_adjacent_weight(change.to, change.weight);
+				set_incoming_weight(change.from, change.to, change.weight);
+			}
+			else {
+				adjacency_list[change.from].add_adjacent_vertex(change.to, change.weight);
+				incoming[change.to].push_back(make_pair(change.from, change.weight));
+			}
+			stats.edges_changed++;
+
+			// A deleted or heavier tree edge invalidates the cost of the vertex it leads to
+			// A new or lighter edge may give the vertex it leads to a lower cost
+			const bool heavier = had_edge && (change.kind == EdgeChangeKind::DELETE || old_weight < change.weight);
+			if (heavier && adjacency_list[change.to].getPath() == change.from) {
+				affected_roots.push_back(change.to);
+			}
+			if (change.kind != EdgeChangeKind::DELETE && (!had_edge || change.weight < old_weight)) {
+				lighter_edges.push_back(i);
+			}
+		}
+
+		// Step 1: collect the affected vertices, the subtrees below the affected roots
+		vector<int> affected_vertices;
+		for (size_t i = 0; i < affected_roots.size(); i++) {
+			mark_subtree(affected_roots[i], affected_vertices);
+		}
+		for (size_t i = 0; i < affected_vertices.size(); i++) {
+			set_cost(affected_vertices[i], infinity, NO_VERTEX);
+		}
+		stats.vertices_affected = affected_vertices.size();
+
+		// Step 2: the best cost of each affected vertex through an edge from an unaffected vertex
+		queue_.makeEmpty();
+		for (size_t i = 0; i < affected_vertices.size(); i++) {
+			int v = affected_vertices[i];
+			for (size_t k = 0; k < incoming[v].size(); k++) {
+				int u = incoming[v][k].first;
+				if (affected[u]) { continue; }
+				STATS_COUNT(edges_relaxed);
+				Weight new_cost = WeightTraits<Weight>::add(adjacency_list[u].get_minPathCost(), incoming[v][k].second);
+				if (new_cost < adjacency_list[v].get_minPathCost()) {
+					set_cost(v, new_cost, u);
+				}
+			}
+			if (adjacency_list[v].get_minPathCost() < infinity) {
+				QueueEntry<Weight> entry = { adjacency_list[v].get_minPathCost(), v };
+				queue_.insert(entry);
+			}
+		}
+		for (size_t i = 0; i < affected_vertices.size(); i++) {
+			affected[affected_vertices[i]] = false;
+		}
+
+		// Step 3: relax the new and lighter edges with their current weight
+		for (size_t i = 0; i < lighter_edges.size(); i++) {
+			const EdgeChange<Weight>& change = batch[lighter_edges[i]];
+			Weight weight;
+			if (find_weight(change.from, change.to, weight)) {
+				relax(change.from, change.to, weight);
+			}
+		}
+
+		// Step 4: spread the lower costs
+		while (!queue_.isEmpty()) {
+			QueueEntry<Weight> top;
+			queue_.deleteMin(top);
+			if (adjacency_list[top.id].get_minPathCost() != top.distance) { continue; }
+			STATS_COUNT(vertices_settled);
+			for (auto edge : adjacency_list[top.id].adjacent()) {
+				relax(top.id, edge.first, edge.second);
+			}
+		}
+
+		// A vertex is updated if its cost or path is different from before the batch
+		for (size_t i = 0; i < changed_vertices.size(); i++) {
+			const int v = changed_vertices[i].id;
+			if (adjacency_list[v].get_minPathCost() != changed_vertices[i].cost || adjacency_list[v].getPath() != changed_vertices[i].path) {
+				stats.vertices_updated++;
+			}
+			changed[v] = false;
+		}
+		changed_vertices.clear();
+
+		stats.milliseconds = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+		return stats;
+	}
+
+private:
+
+	// Cost and path of a vertex before the current batch
+	struct SavedCost {
+		int id;
+		Weight cost;
+		int path;
+	};
+
+	vector<Vertex<int, Weight>>& adjacency_list;
+	int starting_vertex;
+
+	// incoming[v] holds the (vertex, weight) pairs of the edges into v
+	vector<vector<pair<int, Weight>>> incoming;
+
+	// Marks the affected vertices during a batch
+	vector<bool> affected;
+
+	// Marks the vertices whose cost or path has been set during a batch, and their old values
+	vector<bool> changed;
+	vector<SavedCost> changed_vertices;
+
+	// Vertices whose cost went down, by cost
+	BinaryHeap<QueueEntry<Weight>> queue_;
+
+	// Finds the weight of the first edge from one vertex to another; returns false if there is none
+	bool find_weight(int from, int to, Weight& weight) const
+	{
+		for (auto edge : adjacency_list[from].adjacent()) {
+			if (edge.first == to) {
+				weight = edge.second;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	// Changes the weight of the first incoming edge of to that comes from from
+	void set_incoming_weight(int from, int to, Weight weight)
+	{
+		for (size_t k = 0; k < incoming[to].size(); k++) {
+			if (incoming[to][k].first == from) {
+				incoming[to][k].second = weight;
+				return;
+			}
+		}
+	}
+
+	// Removes the first incoming edge of to that comes from from
+	void remove_incoming(int from, int to)
+	{
+		for (size_t k = 0; k < incoming[to].size(); k++) {
+			if (incoming[to][k].first == from) {
+				incoming[to].erase(incoming[to].begin() + k);
+				return;
+			}
+		}
+	}
+
+	// Saves the cost and path of a vertex the first time they are set during a batch
+	void remember(int v)
+	{
+		if (!changed[v]) {
+			changed[v] = true;
+			SavedCost saved = { v, adjacency_list[v].get_minPathCost(), adjacency_list[v].getPath() };
+			changed_vertices.push_back(saved);
+		}
+	}
+
+	// Sets the cost and path of a vertex; distance is kept equal to the cost, as dijkstra() leaves it
+	void set_cost(int v, Weight cost, int path)
+	{
+		remember(v);
+		adjacency_list[v].set_minPathCost(cost);
+		adjacency_list[v].setDistance(cost);
+		adjacency_list[v].setPath(path);
+	}
+
+	// Marks root and every vertex below it in the shortest path tree as affected, and adds them to vertices
+	void mark_subtree(int root, vector<int>& vertices)
+	{
+		if (affected[root] || root == starting_vertex) { return; }
+		affected[root] = true;
+		size_t first = vertices.size();
+		vertices.push_back(root);
+		for (size_t i = first; i < vertices.size(); i++) {
+			int v = vertices[i];
+			for (auto edge : adjacency_list[v].adjacent()) {
+				int w = edge.first;
+				if (!affected[w] && w != starting_vertex && adjacency_list[w].getPath() == v) {
+					affected[w] = true;
+					vertices.push_back(w);
+				}
+			}
+		}
+	}
+
+	// Lowers the cost of to if the edge from from gives it a cheaper path, and queues it
+	void relax(int from, int to, Weight weight)
+	{
+		STATS_COUNT(edges_relaxed);
+		Weight new_cost = WeightTraits<Weight>::add(adjacency_list[from].get_minPathCost(), weight);
+		if (new_cost < adjacency_list[to].get_minPathCost()) {
+			set_cost(to, new_cost, from);
+			QueueEntry<Weight> entry = { new_cost, to };
+			queue_.insert(entry);
+		}
+	}
+};
+
+// @ update_filename: file of edge changes
+// @ names: labels of the vertices in the graph
+// @ batches: receives the batches of changes in the file
+// Reads an update file; each line is one change, and batches are separated by blank lines:
+//     insert <from> <to> <weight>
+//     delete <from> <to>
+//     change <from> <to> <weight>
+// Lines with an unknown change or a vertex that is not in the graph are skipped with a message
+// Returns false if the file cannot be opened
+template <typename Weight>
+bool read_update_batches(const string& update_filename, const NameTable& names, vector<vector<EdgeChange<Weight>>>& batches)
+{
+	ifstream updates(update_filename);
+	if (!updates.is_open()) {
+		return false;
+	}
+
+	batches.assign(1, vector<EdgeChange<Weight>>());
+	string line, kind, from, to;
+	double weight;
+	while (getline(updates, line)) {
+		stringstream ss(line);
+		if (!(ss >> kind)) {
+			// A blank line ends the batch
+			if (!batches.back().empty()) {
+				batches.push_back(vector<EdgeChange<Weight>>());
+			}
+			continue;
+		}
+
+		EdgeChange<Weight> change;
+		change.weight = 0;
+		if (kind == "insert") { change.kind = EdgeChangeKind::INSERT; }
+		else if (kind == "delete") { change.kind = EdgeChangeKind::DELETE; }
+		else if (kind == "change") { change.kind = EdgeChangeKind::CHANGE; }
+		else {
+			cout << "Skipping update with unknown change: " << line << endl;
+			continue;
+		}
+		if (!(ss >> from >> to) || (change.kind != EdgeChangeKind::DELETE && !(ss >> weight))) {
+			cout << "Skipping incomplete update: " << line << endl;
+			continue;
+		}
+		change.from = names.find(from);
+		change.to = names.find(to);
+		if (change.from == NO_VERTEX || change.to == NO_VERTEX) {
+			cout << "Skipping update with a vertex not in the graph: " << line << endl;
+			continue;
+		}
+		if (change.kind != EdgeChangeKind::DELETE && !(weight >= 0)) {
+			cout << "Skipping update with a negative weight: " << line << endl;
+			continue;
+		}
+		if (change.kind != EdgeChangeKind::DELETE) {
+			change.weight = WeightTraits<Weight>::from_double(weight);
+		}
+		batches.back().push_back(change);
+	}
+	if (batches.back().empty()) {
+		batches.pop_back();
+	}
+	return true;
+}
+
+#endif
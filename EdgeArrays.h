@@ -0,0 +1,60 @@
+/*
+	Author: Vishnu Rampersaud
+	EdgeArrays.h header file
+	Copies the edges of an adjacency list into flat arrays, forward or reversed, for the algorithms that
+	sweep over every edge many times
+*/
+#ifndef EDGE_ARRAYS_H
+#define EDGE_ARRAYS_H
+
+#include "Vertex.h"
+#include <vector>
+#include <cstddef>
+using namespace std;
+
+// EdgeArrays class
+// The edges of a graph in three flat arrays (compressed sparse rows): the edges out of vertex v are
+// first[v] up to first[v + 1]. Built reversed, the edges out of v are the edges into v in the graph.
+template <typename Weight>
+struct EdgeArrays {
+	vector<size_t> first;
+	vector<int> head;
+	vector<Weight> weight;
+
+	// @ adjacency_list: the graph
+	// @ reverse: true to turn every edge around
+	EdgeArrays(const vector<Vertex<int, Weight>>& adjacency_list, bool reverse) : first(adjacency_list.size() + 1, 0)
+	{
+		const size_t n = adjacency_list.size();
+		for (size_t v = 0; v < n; v++) {
+			if (!reverse) {
+				first[v + 1] = adjacency_list[v].adjacent_count();
+				continue;
+			}
+			for (auto edge : adjacency_list[v].adjacent()) {
+				first[edge.first + 1]++;
+			}
+		}
+		for (size_t v = 0; v < n; v++) {
+			first[v + 1] += first[v];
+		}
+
+		head.resize(first[n]);
+		weight.resize(first[n]);
+		vector<size_t> next(first.begin(), first.end() - 1);
+		for (size_t v = 0; v < n; v++) {
+			for (auto edge : adjacency_list[v].adjacent()) {
+				const size_t from = reverse ? edge.first : v;
+				head[next[from]] = reverse ? v : edge.first;
+				weight[next[from]++] = edge.second;
+			}
+		}
+	}
+
+	int vertex_count() const
+	{
+		return first.size() - 1;
+	}
+};
+
+#endif
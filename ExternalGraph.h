@@ -0,0 +1,567 @@
+/*
+	Author: Vishnu Rampersaud
+	ExternalGraph.h header file
+	Shortest paths for graphs whose edges do not fit in memory
+*/
+#ifndef EXTERNAL_GRAPH_H
+#define EXTERNAL_GRAPH_H
+
+#include "AdjacencyList.h"
+#include "FindPaths.h"
+#include "NameTable.h"
+#include "WeightTraits.h"
+#include "binary_heap.h"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <chrono>
+#include <cstring>
+#include <cstdint>
+#include <fcntl.h>
+#include <unistd.h>
+using namespace std;
+
+// External adjacency file
+// The edges of the graph are split into partitions of consecutive vertex IDs, and each partition is
+// stored as one block, so it can be read with a single sequential read:
+//
+//   header        ExternalHeader
+//   partitions    for each partition: uint64 first[k + 1], int32 targets[m] (padded to 8 bytes), Weight weights[m]
+//                 where k is the number of vertices in the partition and m the number of edges;
+//                 the edges of the partition's i-th vertex are targets/weights[first[i]] up to [first[i + 1]]
+//   directory     for each partition: uint64 offset, uint64 bytes
+//   labels        for each vertex: uint32 length, then the characters of its label
+//
+// Only the vertex labels and the per-vertex state of the algorithm are kept in memory.
+
+// Fixed size header at the start of an external adjacency file
+struct ExternalHeader {
+	char magic[8];
+	uint32_t weight_size;
+	uint32_t vertices_per_partition;
+	uint64_t number_of_vertices;
+	uint64_t number_of_edges;
+	uint64_t number_of_partitions;
+	uint64_t directory_offset;
+	uint64_t labels_offset;
+};
+
+const char EXTERNAL_MAGIC[8] = { 'G', 'R', 'A', 'P', 'H', 'E', 'X', 'T' };
+
+// Returns true if the file is an external adjacency file
+inline bool is_external_graph_file(const string& filename)
+{
+	ifstream file(filename, ios::binary);
+	char magic[8];
+	return file.read(magic, sizeof(magic)) && memcmp(magic, EXTERNAL_MAGIC, sizeof(magic)) == 0;
+}
+
+// Appends a value of type T to a partition block
+template <typename T>
+void append_raw(vector<char>& block, const T& value)
+{
+	const char* raw = reinterpret_cast<const char*>(&value);
+	block.insert(block.end(), raw, raw + sizeof(T));
+}
+
+// @ out: the external adjacency file being written
+// @ first, targets, weights: the edges of one partition
+// @ directory: receives the offset and size of the block
+// Writes the edges of one partition as a block
+template <typename Weight>
+void write_partition(ofstream& out, const vector<uint64_t>& first, const vector<int32_t>& targets,
+	const vector<Weight>& weights, vector<uint64_t>& directory)
+{
+	vector<char> block;
+	for (size_t i = 0; i < first.size(); i++) { append_raw(block, first[i]); }
+	for (size_t i = 0; i < targets.size(); i++) { append_raw(block, targets[i]); }
+	while (block.size() % 8 != 0) { block.push_back(0); }
+	for (size_t i = 0; i < weights.size(); i++) { append_raw(block, weights[i]); }
+
+	directory.push_back(static_cast<uint64_t>(out.tellp()));
+	directory.push_back(block.size());
+	out.write(block.data(), block.size());
+}
+
+// @ graph_filename: name of the graph text file
+// @ external_filename: name of the external adjacency file to write
+// @ vertices_per_partition: number of consecutive vertex IDs stored in each partition
+// Converts a graph file into an external adjacency file without building the adjacency list in memory
+// Vertex IDs are assigned the same way as createAdjacencyList; the edges of a vertex must all be on
+// its own line, and vertex lines must not repeat (a repeated line is reported and skipped)
+// Returns false, after printing why, if the files could not be opened or a weight is negative
+template <typename Weight>
+bool build_external_graph(const string& graph_filename, const string& external_filename, int vertices_per_partition)
+{
+	STATS_PHASE(build_timer, "build_external_graph");
+	ifstream graph_(graph_filename);
+	ofstream out(external_filename, ios::binary | ios::trunc);
+	if (!graph_.is_open() || !out.is_open()) {
+		cout << "Could not write " << external_filename << endl;
+		return false;
+	}
+
+	// First pass: number the vertices that have their own line, in file order
+	NameTable names;
+	string line;
+	int counter = 0;
+	size_t position, token_begin;
+	while (getline(graph_, line)) {
+		position = 0;
+		if (!next_token(line, position, token_begin)) { continue; }
+		if (++counter == 1) {
+			names = NameTable(atoi(line.c_str() + token_begin));
+			continue;
+		}
+		names.intern(line.data() + token_begin, position - token_begin);
+	}
+
+	// Leave room for the header; it is written last, once the counts are known
+	ExternalHeader header;
+	memset(&header, 0, sizeof(header));
+	out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+	// Second pass: write the partitions in order; only one partition is held in memory at a time
+	vector<uint64_t> directory, first(1, 0);
+	vector<int32_t> targets;
+	vector<Weight> weights;
+	int vertices_written = 0;
+	uint64_t number_of_edges = 0;
+
+	// Writes the current partition once it holds vertices_per_partition vertices
+	auto write_if_full = [&]() {
+		if (static_cast<int>(first.size()) - 1 == vertices_per_partition) {
+			write_partition(out, first, targets, weights, directory);
+			first.assign(1, 0);
+			targets.clear();
+			weights.clear();
+		}
+	};
+
+	graph_.clear();
+	graph_.seekg(0);
+	counter = 0;
+	while (getline(graph_, line)) {
+		position = 0;
+		if (!next_token(line, position, token_begin)) { continue; }
+		if (++counter == 1) { continue; }
+
+		int vertex_id = names.intern(line.data() + token_begin, position - token_begin);
+		if (vertex_id < vertices_written) {
+			cout << "Vertex " << names.name(vertex_id) << " has more than one line; ignoring the extra line" << endl;
+			continue;
+		}
+
+		// Vertices before this one that have no line of their own get no edges
+		for (; vertices_written < vertex_id; vertices_written++) {
+			write_if_full();
+			first.push_back(targets.size());
+		}
+		write_if_full();
+
+		while (next_token(line, position, token_begin)) {
+			targets.push_back(names.intern(line.data() + token_begin, position - token_begin));
+			Weight weight = 0;
+			if (next_token(line, position, token_begin)) {
+				double value = strtod(line.c_str() + token_begin, nullptr);
+				if (!(value >= 0)) {
+					cout << "Edge " << names.name(vertex_id) << " -> " << names.name(targets.back()) << " in " << graph_filename
+						<< " has weight " << line.substr(token_begin, position - token_begin) << "; weights must not be negative" << endl;
+					return false;
+				}
+				weight = WeightTraits<Weight>::from_double(value);
+			}
+			weights.push_back(weight);
+			number_of_edges++;
+		}
+		first.push_back(targets.size());
+		vertices_written++;
+	}
+
+	// Vertices that only appear as the target of an edge have no edges
+	const int n = names.size();
+	for (; vertices_written < n; vertices_written++) {
+		write_if_full();
+		first.push_back(targets.size());
+	}
+	if (first.size() > 1) {
+		write_partition(out, first, targets, weights, directory);
+	}
+
+	// Directory, labels, and finally the header
+	memcpy(header.magic, EXTERNAL_MAGIC, sizeof(header.magic));
+	header.weight_size = sizeof(Weight);
+	header.vertices_per_partition = vertices_per_partition;
+	header.number_of_vertices = n;
+	header.number_of_edges = number_of_edges;
+	header.number_of_partitions = directory.size() / 2;
+	header.directory_offset = static_cast<uint64_t>(out.tellp());
+	out.write(reinterpret_cast<const char*>(directory.data()), directory.size() * sizeof(uint64_t));
+
+	header.labels_offset = static_cast<uint64_t>(out.tellp());
+	for (int id = 0; id < n; id++) {
+		string label = names.name(id);
+		uint32_t length = label.size();
+		out.write(reinterpret_cast<const char*>(&length), sizeof(length));
+		out.write(label.data(), length);
+	}
+
+	out.seekp(0);
+	out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	if (!out) {
+		cout << "Could not write " << external_filename << endl;
+		return false;
+	}
+	return true;
+}
+
+// ExternalGraph class
+// Reads the partitions of an external adjacency file on demand, keeping the most recently used
+// partitions in a cache of fixed size, and counts the I/O that was needed
+template <typename Weight>
+class ExternalGraph {
+public:
+
+	// One partition of the graph in memory
+	struct Partition {
+		vector<char> block;          // the partition as read from the file; 8-byte aligned
+		const uint64_t* first;       // first[i] is the index of the first edge of the partition's i-th vertex
+		const int32_t* targets;      // target vertex of each edge
+		const Weight* weights;       // weight of each edge
+		unsigned long long last_used;
+	};
+
+	ExternalGraph() : fd(-1), cache_limit(64ull << 20), cache_bytes(0), use_counter(0),
+		bytes_read(0), reads(0), partition_reads(0), io_seconds(0), read_error(false)
+	{
+	}
+
+	~ExternalGraph()
+	{
+		if (fd != -1) { close(fd); }
+	}
+
+	// @ filename: name of the external adjacency file
+	// @ names: receives the labels of the vertices
+	// @ cache_megabytes: memory to use for cached partitions
+	// Opens the file and reads its header, directory and labels
+	// Returns false if the file is not an external adjacency file for this weight type, or is cut short
+	bool open_file(const string& filename, NameTable& names, size_t cache_megabytes)
+	{
+		fd = open(filename.c_str(), O_RDONLY);
+		if (fd == -1 || pread(fd, &header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header))
+			|| memcmp(header.magic, EXTERNAL_MAGIC, sizeof(header.magic)) != 0 || header.weight_size != sizeof(Weight)) {
+			return false;
+		}
+		cache_limit = cache_megabytes << 20;
+
+		directory.resize(2 * header.number_of_partitions);
+		if (!read_exactly(directory.data(), directory.size() * sizeof(uint64_t), header.directory_offset)) {
+			return false;
+		}
+		partitions.resize(header.number_of_partitions);
+
+		// Every partition must lie before the labels; read the labels in one piece and intern them in ID order
+		off_t end = lseek(fd, 0, SEEK_END);
+		if (end < 0 || header.labels_offset > static_cast<uint64_t>(end)) {
+			return false;
+		}
+		for (uint64_t p = 0; p < header.number_of_partitions; p++) {
+			if (directory[2 * p] > header.labels_offset || directory[2 * p + 1] > header.labels_offset - directory[2 * p]) {
+				return false;
+			}
+		}
+		vector<char> labels(end - header.labels_offset);
+		if (!read_exactly(labels.data(), labels.size(), header.labels_offset)) {
+			return false;
+		}
+		names = NameTable(header.number_of_vertices);
+		size_t position = 0;
+		for (uint64_t id = 0; id < header.number_of_vertices; id++) {
+			uint32_t length;
+			if (labels.size() - position < sizeof(length)) {
+				return false;
+			}
+			memcpy(&length, labels.data() + position, sizeof(length));
+			if (labels.size() - position - sizeof(length) < length) {
+				return false;
+			}
+			names.intern(labels.data() + position + sizeof(length), length);
+			position += sizeof(length) + length;
+		}
+		return true;
+	}
+
+	int vertex_count() const { return header.number_of_vertices; }
+	unsigned long long edge_count() const { return header.number_of_edges; }
+	int partition_count() const { return header.number_of_partitions; }
+
+	// Returns the partition that holds vertex v
+	int partition_of(int v) const
+	{
+		return v / header.vertices_per_partition;
+	}
+
+	// Returns the index of v within its partition
+	int index_in_partition(int v) const
+	{
+		return v % header.vertices_per_partition;
+	}
+
+	// @ p: a partition number
+	// Returns partition p, reading it from the file if it is not cached
+	// The pointer stays valid until the next call to load()
+	// Returns nullptr, and read_failed() is true afterwards, if the partition could not be read in full
+	const Partition* load(int p)
+	{
+		Partition& partition = partitions[p];
+		partition.last_used = ++use_counter;
+		if (!partition.block.empty()) {
+			return &partition;
+		}
+
+		// Evict the least recently used partitions until the new one fits
+		size_t size = directory[2 * p + 1];
+		while (cache_bytes + size > cache_limit && !cached.empty()) {
+			size_t oldest = 0;
+			for (size_t i = 1; i < cached.size(); i++) {
+				if (partitions[cached[i]].last_used < partitions[cached[oldest]].last_used) {
+					oldest = i;
+				}
+			}
+			cache_bytes -= partitions[cached[oldest]].block.size();
+			vector<char>().swap(partitions[cached[oldest]].block);
+			cached[oldest] = cached.back();
+			cached.pop_back();
+		}
+
+		// vector<char> memory comes from operator new, so it is aligned for the uint64 and Weight arrays
+		partition.block.resize(size);
+		partition_reads++;
+		uint64_t vertices = min<uint64_t>(header.vertices_per_partition,
+			header.number_of_vertices - static_cast<uint64_t>(p) * header.vertices_per_partition);
+		size_t targets_offset = (vertices + 1) * sizeof(uint64_t);
+		if (!read_exactly(partition.block.data(), size, directory[2 * p]) || size < targets_offset) {
+			return fail(partition);
+		}
+		partition.first = reinterpret_cast<const uint64_t*>(partition.block.data());
+		uint64_t edges = partition.first[vertices];
+		size_t weights_offset = (targets_offset + edges * sizeof(int32_t) + 7) / 8 * 8;
+		if (edges > size || weights_offset + edges * sizeof(Weight) > size) {
+			return fail(partition);
+		}
+		partition.targets = reinterpret_cast<const int32_t*>(partition.block.data() + targets_offset);
+		partition.weights = reinterpret_cast<const Weight*>(partition.block.data() + weights_offset);
+		cache_bytes += size;
+		cached.push_back(p);
+		return &partition;
+	}
+
+	// Returns true if a partition could not be read since the file was opened
+	bool read_failed() const { return read_error; }
+
+	// I/O counters
+	unsigned long long total_bytes_read() const { return bytes_read; }
+	unsigned long long total_reads() const { return reads; }
+	unsigned long long total_partition_reads() const { return partition_reads; }
+	double io_time() const { return io_seconds; }
+
+private:
+	int fd;
+	ExternalHeader header;
+	vector<uint64_t> directory;
+	vector<Partition> partitions;
+	vector<int> cached;
+	size_t cache_limit, cache_bytes;
+	unsigned long long use_counter;
+
+	unsigned long long bytes_read, reads, partition_reads;
+	double io_seconds;
+	bool read_error;
+
+	// Reads size bytes at offset into buffer, and counts the I/O
+	// Returns false if the file ends or the read fails first
+	bool read_exactly(void* buffer, size_t size, uint64_t offset)
+	{
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		size_t done = 0;
+		while (done < size) {
+			ssize_t result = pread(fd, static_cast<char*>(buffer) + done, size - done, offset + done);
+			if (result <= 0) {
+				break;
+			}
+			done += result;
+		}
+		io_seconds += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+		bytes_read += done;
+		reads++;
+		return done == size;
+	}
+
+	// Drops a partition that could not be read and records the error; returns nullptr for load()
+	const Partition* fail(Partition& partition)
+	{
+		vector<char>().swap(partition.block);
+		read_error = true;
+		return nullptr;
+	}
+};
+
+// Counters from a run of the external Dijkstra
+struct ExternalStats {
+	unsigned long long partition_visits;   // times a partition was worked on, whether or not it was cached
+	unsigned long long partition_reads;    // times a partition had to be read from the file
+	unsigned long long vertices_settled;
+	unsigned long long vertices_reopened;
+	unsigned long long edges_relaxed;
+	double seconds;
+};
+
+// External memory Dijkstra's algorithm
+// The distances and paths of the vertices stay in memory; the edges are read partition by partition
+// Tentative distances are queued per partition, and the partition with the smallest queued distance
+// is loaded and worked on for as long as its smallest distance is no larger than any other partition's.
+// Relaxations into other partitions are only queued there, so they cost no I/O until that partition
+// is loaded. With slack 0, vertices are settled in exact Dijkstra order.
+// A positive slack keeps working on the loaded partition while its smallest distance is within slack of
+// the other partitions', which saves partition reads when the cache is small. A vertex settled too early
+// is reopened when a shorter path to it is found later, so the result is still exact.
+// The search stops early if a partition cannot be read from the file; graph.read_failed() is then true.
+// @ graph: the external graph
+// @ starting_vertex: ID of the starting vertex
+// @ distance: receives the cost of the shortest path to each vertex (infinity if unreachable)
+// @ path: receives the previous vertex on the shortest path to each vertex (NO_VERTEX for none)
+// @ slack: how far past the smallest distance of the other partitions the loaded partition may go
+template <typename Weight>
+ExternalStats external_dijkstra(ExternalGraph<Weight>& graph, int starting_vertex, vector<Weight>& distance,
+	vector<int>& path, Weight slack = 0)
+{
+	STATS_PHASE(dijkstra_timer, "external_dijkstra");
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	ExternalStats stats = { 0, 0, 0, 0, 0, 0 };
+	const unsigned long long reads_before = graph.total_partition_reads();
+
+	const int n = graph.vertex_count();
+	distance.assign(n, WeightTraits<Weight>::infinity());
+	path.assign(n, NO_VERTEX);
+	vector<bool> settled(n, false);
+
+	vector<BinaryHeap<QueueEntry<Weight>>> pending(graph.partition_count(), BinaryHeap<QueueEntry<Weight>>(4));
+	BinaryHeap<QueueEntry<Weight>> partition_queue;
+
+	QueueEntry<Weight> entry = { 0, starting_vertex };
+	distance[starting_vertex] = 0;
+	pending[graph.partition_of(starting_vertex)].insert(entry);
+	entry.id = graph.partition_of(starting_vertex);
+	partition_queue.insert(entry);
+
+	while (!partition_queue.isEmpty()) {
+		QueueEntry<Weight> next_partition;
+		partition_queue.deleteMin(next_partition);
+		int p = next_partition.id;
+
+		// Skip entries made stale by a later, smaller distance in the same partition
+		if (pending[p].isEmpty() || next_partition.distance != pending[p].findMin().distance) {
+			continue;
+		}
+
+		const typename ExternalGraph<Weight>::Partition* partition = graph.load(p);
+		if (partition == nullptr) {
+			break;
+		}
+		stats.partition_visits++;
+
+		while (!pending[p].isEmpty()) {
+			QueueEntry<Weight> top = pending[p].findMin();
+			if (settled[top.id] || top.distance != distance[top.id]) {
+				pending[p].deleteMin();
+				continue;
+			}
+
+			// Drop stale partition entries so the comparison below uses a real distance
+			while (!partition_queue.isEmpty()) {
+				const QueueEntry<Weight>& other = partition_queue.findMin();
+				if (!pending[other.id].isEmpty() && pending[other.id].findMin().distance == other.distance) { break; }
+				partition_queue.deleteMin();
+			}
+
+			// Another partition has a closer vertex; switch to it
+			if (!partition_queue.isEmpty() && WeightTraits<Weight>::add(partition_queue.findMin().distance, slack) < top.distance) {
+				break;
+			}
+
+			pending[p].deleteMin();
+			settled[top.id] = true;
+			stats.vertices_settled++;
+			STATS_COUNT(vertices_settled);
+
+			int index = graph.index_in_partition(top.id);
+			for (uint64_t e = partition->first[index]; e < partition->first[index + 1]; e++) {
+				int w = partition->targets[e];
+				Weight new_distance = WeightTraits<Weight>::add(top.distance, partition->weights[e]);
+				stats.edges_relaxed++;
+				STATS_COUNT(edges_relaxed);
+				if (new_distance < distance[w]) {
+					distance[w] = new_distance;
+					path[w] = top.id;
+					if (settled[w]) {
+						settled[w] = false;
+						stats.vertices_reopened++;
+					}
+
+					int q = graph.partition_of(w);
+					bool new_minimum = pending[q].isEmpty() || new_distance < pending[q].findMin().distance;
+					QueueEntry<Weight> relaxed = { new_distance, w };
+					pending[q].insert(relaxed);
+					if (q != p && new_minimum) {
+						QueueEntry<Weight> key = { new_distance, q };
+						partition_queue.insert(key);
+					}
+				}
+			}
+		}
+
+		// Come back to this partition when its smallest distance is the smallest again
+		if (!pending[p].isEmpty()) {
+			QueueEntry<Weight> key = { pending[p].findMin().distance, p };
+			partition_queue.insert(key);
+		}
+	}
+
+	stats.partition_reads = graph.total_partition_reads() - reads_before;
+	stats.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+	return stats;
+}
+
+// Prints the shortest path and cost of every vertex, in the same order and format as printOutput()
+// @ names: labels of the vertices
+// @ distance, path: the result of external_dijkstra()
+template <typename Weight>
+void printExternalOutput(const NameTable& names, const vector<Weight>& distance, const vector<int>& path)
+{
+	STATS_PHASE(output_timer, "output");
+	vector<int> output_order(names.size());
+	for (int v = 0; v < names.size(); v++) {
+		output_order[v] = v;
+	}
+	sort_by_integer_label(names, output_order);
+
+	vector<int> vertices_on_path;
+	for (size_t i = 0; i < output_order.size(); i++) {
+		const int v = output_order[i];
+		cout << names.name(v) << ": ";
+
+		// Walk back to the start without recursion; paths in large graphs can be very long
+		vertices_on_path.clear();
+		for (int u = v; u != NO_VERTEX; u = path[u]) {
+			vertices_on_path.push_back(u);
+		}
+		for (size_t j = vertices_on_path.size(); j-- > 0; ) {
+			cout << names.name(vertices_on_path[j]) << (j > 0 ? ", " : "");
+		}
+		cout << " (Cost: " << distance[v] << ")" << endl;
+	}
+}
+
+#endif
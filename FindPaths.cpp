@@ -3,223 +3,305 @@
 	Uses Dijkstra's algorithm to find the shortest path to all vertices
 */
 
-#include "Vertex.h"
-#include "binary_heap.h"
+#include "AdjacencyList.h"
+#include "FindPaths.h"
+#include "VertexOrdering.h"
+#include "ExternalGraph.h"
+#include "DynamicPaths.h"
+#include "GraphSnapshot.h"
+#include "KShortestPaths.h"
+#include "BoundedSearch.h"
+#include "BreadthFirstSearch.h"
+#include "Components.h"
+#include "Centrality.h"
 #include <iostream>
 #include <string>
 #include <vector>
 #include <fstream>
 #include <sstream>
-#include <map>
 #include <limits>
 #include <utility>
+#include <memory>
+#include <atomic>
+#include <thread>
 using namespace std;
 
-// @graph_filename: name of the graph file
-// @adjacency_list: Empty map to create adjacency list with 
-// This function Uses a map structure to store vertices of a graph into an adjacency list 
-template<typename Type>
-void createAdjacencyList(const string& graph_filename, map <Type, Vertex<Type>>& adjacency_list)
+bool testFiles(const vector<string>& files)
 {
-	// Open graph text file that has the specifications of the graph, vertices, edges, and weights 
-	ifstream graph_;
-	graph_.open(graph_filename);
-
-	string line;
-	int counter = 0, number_of_vertices = 0;
-
-	// Read each line of the graph text file, and create an adjacency list 
-	while (!graph_.eof())
-	{
-		// get current line of the file which contains a Vertex and all of its adjacent vertices/ edges and weights 
-		getline(graph_, line);
-
-		if (line.empty()) { continue; }
-
-		// counter to keep track of which line the program is reading in the file 
-		counter++;
-
-		// The first line gives the number of vertices for the graph
-		// When program is at the first line, store the number of vertices into a variable, number_of_vertices 
-		if (counter == 1) {
-			stringstream ss(line);
-			ss >> number_of_vertices;
+	ifstream file;
+	for (size_t i = 0; i < files.size(); i++) {
+		file.open(files[i]);
+		if (file.is_open()) {
+			file.close();
 			continue;
 		}
-
-		// For each vertex in the graph, store their adjacent vertices and the corresponding weights into a map 
-		// This map will be the adjacency list
-		stringstream ss(line);
-		for (int i = 0; i < number_of_vertices; i++) {
-
-			Type vertex_name, adjacent_vertex;
-			double adjacent_weight;
-
-			// First element in the line is the vertex name
-			ss >> vertex_name;
-
-			// Create a new Vertex object that will hold all adjacent vertices and their weights
-			Vertex<Type> v(vertex_name);
-
-			// Add each adjacent vertex and its weight into the Vertex object
-			while (ss >> adjacent_vertex) {
-
-				ss >> adjacent_weight;
-
-				v.add_adjacent_vertex(adjacent_vertex, adjacent_weight);
-			}
-
-			// Add vertex to map (adjacency list) 
-			// This vertex now contains all data about its adjacent vertices and weights
-			adjacency_list.insert(pair<Type, Vertex<Type>> {vertex_name, v});
+		else {
+			cout << files[i] << " does not exist in the current directory." << endl;
+			cout << "Program will terminate" << endl;
+			return false;
 		}
 	}
-	// Close the graph file
-	graph_.close();
+
+	return true;
 }
 
-// Dijkstra's algorithm 
-// Finds the shortest path to all vertices in a graph 
-// @ starting_vertex: the starting vertex of where to start running the algorithm based on user input
-// @ priority_queue: a binary heap priority queue 
-// @ adjacency_list: an adjacency list that represents a graph
-template <typename Type>
-void dijkstra(const Type& starting_vertex, BinaryHeap<Vertex<Type>>& priority_queue, map <Type, Vertex<Type>>& adjacency_list)
+// Queries run by one reader thread while the updates are applied
+struct ReaderCounts {
+	unsigned long long queries;
+	unsigned long long first_version, last_version;
+};
+
+// Applies the batches of edge changes in an update file, and repairs the shortest paths after each batch
+// With readers above 0, that many threads keep running Dijkstra's algorithm on snapshots of the graph
+// while the batches are applied (see GraphSnapshot.h); each batch is published as a new version
+// @ update_filename: file of edge changes (see DynamicPaths.h)
+// @ adjacency_list: the graph, on which dijkstra() has been run
+// @ names: labels of the vertices in the graph
+// @ starting_vertex: ID of the starting vertex
+// @ readers: number of reader threads
+// Returns the number of batches applied
+template <typename Weight>
+size_t applyUpdates(const string& update_filename, vector<Vertex<int, Weight>>& adjacency_list, const NameTable& names,
+	int starting_vertex, int readers)
 {
-	// Make sure the priority queue is empty 
-	priority_queue.makeEmpty();
-
-	// Set a constant for infinity 
-	const int infinity = std::numeric_limits<int>::max();
-
-	// Initialize starting vertex distance, cost, and path to 0
-	// Initialize all other Vertex distances to infinity and path to 0
-	// Then store all Vertices in the priority queue
-	for (auto itr = adjacency_list.begin(); itr != adjacency_list.end(); ++itr) {
-		if (itr->first == starting_vertex) {
-			itr->second.setDistance(0); 
-			itr->second.setPath(0);
-			itr->second.set_minPathCost(0.0); 
-		} 
-		else {
-			itr->second.setDistance(infinity);
-			itr->second.setPath(0);
-		}
-		priority_queue.insert(itr->second); 
+	vector<vector<EdgeChange<Weight>>> batches;
+	read_update_batches(update_filename, names, batches);
+
+	// Readers search the latest snapshot over and over until the last batch has been applied
+	unique_ptr<VersionedGraph<Weight>> versions(readers > 0 ? new VersionedGraph<Weight>(adjacency_list) : nullptr);
+	atomic<bool> done(false);
+	vector<ReaderCounts> counts(readers);
+	vector<thread> threads;
+	for (int r = 0; r < readers; r++) {
+		threads.push_back(thread([&versions, &done, &counts, starting_vertex, r]() {
+			vector<Weight> distance;
+			vector<int> path;
+			ReaderCounts& count = counts[r];
+			count.queries = 0;
+			do {
+				GraphSnapshot<Weight> snapshot(*versions);
+				snapshot_dijkstra(snapshot, starting_vertex, distance, path);
+				count.last_version = snapshot.version();
+				if (count.queries++ == 0) {
+					count.first_version = snapshot.version();
+				}
+			} while (!done.load());
+		}));
 	}
 
-	// Run Dijkstra's algorithm until the shortest path to all vertices is found
-	while (!priority_queue.isEmpty()) {
-
-		// Delete the minimum value from the heap (smallest distance) 
-		// Store the vertex into a variable, minVertex
-		// This is the vertex with the shortest known distance
-		Vertex<Type> minVertex; 
-		priority_queue.deleteMin(minVertex);
-
-		// get all adjacent vertices of the minimum vertex
-		vector<pair<Type, double>> adjacent_vertices = minVertex.get_adjacent_nodes();
-
-		// get the distance of the minimum vertex
-		double distance_of_minVertex = minVertex.get_distance(); 
-
-		// get the name of the minimum vertex
-		Type name_of_minVertex = minVertex.get_vertex_name();
-
-		// for each vertex that is adjacent to the minimum vertex
-		for (int i = 0; i < adjacent_vertices.size(); i++) {
-
-			// find the adjacent vertex  
-			auto itr = adjacency_list.find(adjacent_vertices[i].first); 
-			if (itr == adjacency_list.end()) {
-				cout << "Error" << endl;
-				return;
-			}
-
-			// get the adjacent vertex name
-			Type adjacent_name = itr->second.get_vertex_name();
-			// get the adjacent vertex distance
-			double adjacent_distance = itr->second.get_distance(); 
-			// get the adjacent vertex edge cost/ weight
-			double adjacent_edge = adjacent_vertices[i].second;
-
-			// Compute a new shortest path distance for this vertex
-			// if it is smaller than the current distance, then update it with this distance 
-			if (distance_of_minVertex + adjacent_edge < adjacent_distance) {
-
-				// Compute the shortest path for this adjacent vertex
-				double new_distance = distance_of_minVertex + adjacent_edge;
-
-				// Update the distance of the adjacent vertex 
-				itr->second.setDistance(new_distance);
-
-				// Update the path variable of this vertex to the minimum vertex
-				itr->second.setPath(name_of_minVertex); 
-
-				// Set the cost of the new shortest path of this vertex
-				itr->second.set_minPathCost(new_distance); 
+	cout << endl;
+	DynamicPaths<Weight> dynamic_paths(adjacency_list, starting_vertex);
+	for (size_t b = 0; b < batches.size(); b++) {
+		UpdateStats update = dynamic_paths.apply_batch(batches[b]);
+		cout << "Batch " << b + 1 << ": " << update.edges_changed << " edges changed, "
+			<< update.vertices_affected << " vertices affected, " << update.vertices_updated
+			<< " vertices updated (" << update.milliseconds << " ms)";
+		if (versions) {
+			cout << ", published as version " << versions->apply(batches[b]);
+		}
+		cout << endl;
+	}
 
-				// Update the distance of this adjacent vertex in the priority queue
-				Vertex<Type> updateQueueValue(adjacent_name);
-				updateQueueValue.setDistance(new_distance); 
-				priority_queue.decreaseKey(updateQueueValue); 
+	done.store(true);
+	for (size_t r = 0; r < threads.size(); r++) {
+		threads[r].join();
+	}
+	if (versions) {
+		versions->reclaim();
+
+		unsigned long long queries = 0;
+		cout << "Snapshot readers:";
+		for (int r = 0; r < readers; r++) {
+			queries += counts[r].queries;
+			cout << (r == 0 ? " " : ", ") << counts[r].queries << " queries on versions "
+				<< counts[r].first_version << " to " << counts[r].last_version;
+		}
+		cout << " (" << queries << " in total)" << endl;
+
+		// The latest version must give the same costs as the repaired paths
+		vector<Weight> distance;
+		vector<int> path;
+		GraphSnapshot<Weight> snapshot(*versions);
+		snapshot_dijkstra(snapshot, starting_vertex, distance, path);
+		size_t mismatches = 0;
+		for (size_t v = 0; v < adjacency_list.size(); v++) {
+			if (distance[v] != adjacency_list[v].get_minPathCost()) {
+				mismatches++;
 			}
 		}
+		cout << "Versions: " << versions->published() << " published, " << versions->copied_blocks() << " blocks copied, "
+			<< versions->reclaimed() << " reclaimed; version " << snapshot.version()
+			<< (mismatches == 0 ? " agrees with the repaired paths" : " differs from the repaired paths at ");
+		if (mismatches != 0) {
+			cout << mismatches << " vertices";
+		}
+		cout << endl;
 	}
+	return batches.size();
 }
 
-// Print shortest path of specified vertex
-// Recursive algorithm 
-// @ v: print the shortest path of this vertex, v
-// @ adjacency_list: adjacency list that represents a graph
-template <typename Type>
-void printPath(const Vertex<Type>& v, const map <Type, Vertex<Type>>& adjacency_list)
+// Runs Dijkstra's algorithm on a graph kept on disk, and prints the same output as the in-memory version
+// followed by the I/O that was needed
+// @ external_filename: an external adjacency file (see ExternalGraph.h)
+// @ starting_label: label of the starting vertex
+// @ cache_megabytes: memory to use for cached partitions
+// @ slack: see external_dijkstra()
+void findExternalPaths(const string& external_filename, const string& starting_label, size_t cache_megabytes, weight_type slack)
 {
-	if (v.getPath() != 0) {
-		auto itr = adjacency_list.find(v.getPath()); 
-		printPath(itr->second, adjacency_list); 
-		cout << ", "; 
+	ExternalGraph<weight_type> graph;
+	NameTable names;
+	if (!graph.open_file(external_filename, names, cache_megabytes)) {
+		cout << external_filename << " is not an external adjacency file for this weight type, or is cut short" << endl;
+		return;
 	}
-	cout << v; 
-}
 
-// Print shortest path of all vertices in the graoh along with their costs
-// @ adjacency_list: adjacency list that represents a graph
-template <typename Type>
-void printOutput(const map <Type, Vertex<Type>>& adjacency_list)
-{
-	for (auto itr = adjacency_list.begin(); itr != adjacency_list.end(); ++itr) {
-		cout << itr->first << ": "; 
-		printPath(itr->second, adjacency_list); 
-		double cost = itr->second.get_minPathCost(); 
-		cout << " (Cost: " << cost << ")" << endl;
+	int starting_vertex = names.find(starting_label);
+	if (starting_vertex == NO_VERTEX) {
+		cout << "Vertex " << starting_label << " not found in " << external_filename << endl;
+		return;
 	}
-}
 
-bool testFiles(const vector<string>& files)
-{
-	ifstream file;
-	for (int i = 0; i < files.size(); i++) {
-		file.open(files[i]);
-		if (file.is_open()) {
-			file.close();
-			continue;
-		}
-		else {
-			cout << files[i] << " does not exist in the current directory." << endl;
-			cout << "Program will terminate" << endl;
-			return false;
-		}
+	vector<weight_type> distance;
+	vector<int> path;
+	ExternalStats stats = external_dijkstra(graph, starting_vertex, distance, path, slack);
+	if (graph.read_failed()) {
+		cout << "Could not read a partition of " << external_filename << "; the file is damaged or cut short" << endl;
+		return;
 	}
 
-	return true;
+	printExternalOutput(names, distance, path);
+
+	double megabytes = graph.total_bytes_read() / 1048576.0;
+	cout << "\nExternal memory: " << graph.partition_count() << " partitions, " << stats.partition_visits << " partition visits, "
+		<< stats.partition_reads << " read from disk, " << graph.total_bytes_read() << " bytes read in " << graph.total_reads() << " reads" << endl;
+	cout << "I/O time: " << graph.io_time() * 1000 << " ms (" << (graph.io_time() > 0 ? megabytes / graph.io_time() : 0)
+		<< " MB/s), total time: " << stats.seconds * 1000 << " ms, " << stats.vertices_settled << " vertices settled, "
+		<< stats.edges_relaxed << " edges relaxed, " << stats.vertices_reopened << " vertices reopened" << endl;
 }
 
 int main(int argc, char** argv)
 {
 	// Checks to see if the correct number of arguments are entered
-	if (argc != 3) {
-		cout << "Usage: " << argv[0] << " <GRAPH_FILE> <STARTING_VERTEX>" << endl;
+	const string usage = string("Usage: ") + argv[0] + " <GRAPH_FILE> <STARTING_VERTEX>"
+		+ " [--order=file|bfs|rcm|hub] [--compress=double|float|uint16]"
+		+ " [--external=<ADJACENCY_FILE>] [--partition=<VERTICES>] [--cache=<MB>] [--slack=<COST>]"
+		+ " [--updates=<UPDATE_FILE> [--readers=<THREADS>]] [--k-paths=<K> --target=<VERTEX>]"
+		+ " [--threads=<THREADS>] [--radius=<COST> [--bands=<N>]] [--radius-queries=<QUERY_FILE>] [--hops] [--components]"
+		+ " [--betweenness[=<SAMPLES>] [--top=<N>]]"
+		+ " [--stats[=<STATS_FILE>]]";
+	if (argc < 3) {
+		cout << usage << endl;
+		return 0;
+	}
+
+	// Read the options that follow the required arguments
+	VertexOrdering ordering = VertexOrdering::FILE_ORDER;
+	bool compress = false;
+	WeightEncoding encoding = WeightEncoding::DOUBLE;
+	string external_filename;
+	int vertices_per_partition = 65536;
+	size_t cache_megabytes = 64;
+	weight_type slack = 0;
+	string stats_destination;
+	string update_filename;
+	int readers = 0;
+	int k_paths = 0;
+	string target_label;
+	int threads = 0;
+	double radius = -1;
+	int bands = 0;
+	string radius_query_filename;
+	bool hop_counts = false;
+	bool components = false;
+	int betweenness_samples = -1;
+	int top = 10;
+	for (int i = 3; i < argc; i++) {
+		const string option(argv[i]);
+		if (option.compare(0, 8, "--order=") == 0 && parse_ordering(option.substr(8), ordering)) {
+			continue;
+		}
+		if (option.compare(0, 11, "--compress=") == 0 && parse_weight_encoding(option.substr(11), encoding)) {
+			compress = true;
+			continue;
+		}
+		if (option.compare(0, 11, "--external=") == 0 && option.size() > 11) {
+			external_filename = option.substr(11);
+			continue;
+		}
+		if (option.compare(0, 12, "--partition=") == 0 && atoi(option.c_str() + 12) > 0) {
+			vertices_per_partition = atoi(option.c_str() + 12);
+			continue;
+		}
+		if (option.compare(0, 8, "--cache=") == 0 && atoi(option.c_str() + 8) > 0) {
+			cache_megabytes = atoi(option.c_str() + 8);
+			continue;
+		}
+		if (option.compare(0, 8, "--slack=") == 0 && atof(option.c_str() + 8) >= 0) {
+			slack = WeightTraits<weight_type>::from_double(atof(option.c_str() + 8));
+			continue;
+		}
+		if (option.compare(0, 10, "--updates=") == 0 && option.size() > 10) {
+			update_filename = option.substr(10);
+			continue;
+		}
+		if (option.compare(0, 10, "--readers=") == 0 && atoi(option.c_str() + 10) >= 0) {
+			readers = min(atoi(option.c_str() + 10), VersionedGraph<weight_type>::MAX_READERS - 1);
+			continue;
+		}
+		if (option.compare(0, 10, "--k-paths=") == 0 && atoi(option.c_str() + 10) > 0) {
+			k_paths = atoi(option.c_str() + 10);
+			continue;
+		}
+		if (option.compare(0, 9, "--target=") == 0 && option.size() > 9) {
+			target_label = option.substr(9);
+			continue;
+		}
+		if (option.compare(0, 10, "--threads=") == 0 && atoi(option.c_str() + 10) >= 0) {
+			threads = atoi(option.c_str() + 10);
+			continue;
+		}
+		if (option.compare(0, 9, "--radius=") == 0 && option.size() > 9 && atof(option.c_str() + 9) >= 0) {
+			radius = atof(option.c_str() + 9);
+			continue;
+		}
+		if (option.compare(0, 8, "--bands=") == 0 && atoi(option.c_str() + 8) > 0) {
+			bands = atoi(option.c_str() + 8);
+			continue;
+		}
+		if (option.compare(0, 17, "--radius-queries=") == 0 && option.size() > 17) {
+			radius_query_filename = option.substr(17);
+			continue;
+		}
+		if (option == "--hops") {
+			hop_counts = true;
+			continue;
+		}
+		if (option == "--components") {
+			components = true;
+			continue;
+		}
+		if (option == "--betweenness") {
+			betweenness_samples = 0;
+			continue;
+		}
+		if (option.compare(0, 14, "--betweenness=") == 0 && atoi(option.c_str() + 14) > 0) {
+			betweenness_samples = atoi(option.c_str() + 14);
+			continue;
+		}
+		if (option.compare(0, 6, "--top=") == 0 && atoi(option.c_str() + 6) >= 0) {
+			top = atoi(option.c_str() + 6);
+			continue;
+		}
+		if (option == "--stats") {
+			stats_destination = "-";
+			continue;
+		}
+		if (option.compare(0, 8, "--stats=") == 0 && option.size() > 8) {
+			stats_destination = option.substr(8);
+			continue;
+		}
+		cout << "Unknown option: " << option << endl;
+		cout << usage << endl;
 		return 0;
 	}
 
@@ -229,30 +311,189 @@ int main(int argc, char** argv)
 	// Test to see if files are valid; If they exist in the current directory
 	vector<string> files;
 	files.push_back(graph_filename);
+	if (!update_filename.empty()) {
+		files.push_back(update_filename);
+	}
+	if (!radius_query_filename.empty()) {
+		files.push_back(radius_query_filename);
+	}
 	if (!testFiles(files)) {
 		return 0;
 	}
 
-	// Cast vertex to int variable because that's what is needed for the project
-	int starting_vertex;
-	starting_vertex = std::atoi(argv[2]); 
+	// Vertex labels are arbitrary tokens; the label is mapped to an ID once the graph is loaded
+	const string starting_label(argv[2]); 
 
 	// Display files that will be used
-	cout << "\nInput Graph file: " << graph_filename << "\nInput Starting Vertex: " << starting_vertex << "\n" << endl;
+	cout << "\nInput Graph file: " << graph_filename << "\nInput Starting Vertex: " << starting_label << "\n" << endl;
+
+	// External memory mode: the edges stay on disk in a partitioned adjacency file
+	// The graph file can be such a file already, or is converted into the file given by --external
+	const bool in_memory_only = !update_filename.empty() || k_paths > 0 || radius >= 0 || !radius_query_filename.empty() || hop_counts || components
+		|| betweenness_samples >= 0;
+	if ((is_external_graph_file(graph_filename) || !external_filename.empty()) && in_memory_only) {
+		cout << "--updates, --k-paths, --radius, --hops, --components and --betweenness cannot be used with an external adjacency file" << endl;
+		return 0;
+	}
+	if ((k_paths > 0) != !target_label.empty()) {
+		cout << "--k-paths and --target must be given together" << endl;
+		return 0;
+	}
+	if (is_external_graph_file(graph_filename)) {
+		findExternalPaths(graph_filename, starting_label, cache_megabytes, slack);
+		report_stats(stats_destination, "FindPaths");
+		return 0;
+	}
+	if (!external_filename.empty()) {
+		if (!build_external_graph<weight_type>(graph_filename, external_filename, vertices_per_partition)) {
+			cout << "Program will terminate" << endl;
+			return 0;
+		}
+		findExternalPaths(external_filename, starting_label, cache_megabytes, slack);
+		report_stats(stats_destination, "FindPaths");
+		return 0;
+	}
 
-	// Create empty map to store adjacency list 
-	map <int, Vertex<int>> adjacency_list;
+	// Create empty vector to store adjacency list, and a table for the vertex labels
+	vector<Vertex<int, weight_type>> adjacency_list;
+	NameTable names;
 
 	// Create empty priority Queue
-	BinaryHeap<Vertex<int>> priority_queue;
+	BinaryHeap<Vertex<int, weight_type>> priority_queue;
 
 	// Create adjacency list to represent the input graph 
-	createAdjacencyList(graph_filename, adjacency_list);
+	if (!createAdjacencyList(graph_filename, adjacency_list, names)) {
+		cout << "Program will terminate" << endl;
+		return 0;
+	}
+
+	// Renumber the vertices to improve memory locality; output_order keeps the original file order,
+	// or numeric order when the labels are integers
+	vector<int> output_order = reorder_vertices(adjacency_list, names, ordering);
+	sort_by_integer_label(names, output_order);
+
+	// Compress the adjacency list to save memory
+	if (compress) {
+		print_compression(encoding, compress_graph(adjacency_list, encoding));
+	}
+
+	// Find the ID of the starting vertex
+	int starting_vertex = names.find(starting_label);
+	if (starting_vertex == NO_VERTEX) {
+		cout << "Vertex " << starting_label << " not found in " << graph_filename << endl;
+		return 0;
+	}
 
-	// Run the Dijkstra algorithm on the graph
-	dijkstra(starting_vertex, priority_queue, adjacency_list); 
+	// Find the components first, so that the vertices they show cannot be reached are not searched for
+	unique_ptr<ComponentIndex> component_index;
+	if (components) {
+		ThreadPool pool(threads);
+		component_index.reset(new ComponentIndex(adjacency_list, pool));
+		printComponents(*component_index);
+		cout << endl;
+	}
+
+	// Rank the vertices by the shortest paths through them, and show where the starting vertex stands
+	if (betweenness_samples >= 0) {
+		ThreadPool pool(threads);
+		Betweenness<weight_type> centrality(adjacency_list, pool);
+		int sources = centrality.run(betweenness_samples);
+		printBetweenness(centrality, names, output_order, starting_vertex, top);
+		cout << "Searched from " << sources << " of " << adjacency_list.size() << " vertices" << endl;
+		report_stats(stats_destination, "FindPaths");
+		return 0;
+	}
+
+	// List the k shortest loopless paths to the target instead of the shortest path to every vertex
+	if (k_paths > 0) {
+		int target_vertex = names.find(target_label);
+		if (target_vertex == NO_VERTEX) {
+			cout << "Vertex " << target_label << " not found in " << graph_filename << endl;
+			return 0;
+		}
+		vector<WeightedPath<weight_type>> paths;
+		if (component_index && component_index->reachability(starting_vertex, target_vertex) == Reachability::UNREACHABLE) {
+			cout << target_label << " cannot be reached from " << starting_label << endl;
+		}
+		else {
+			ThreadPool pool(threads);
+			KShortestPaths<weight_type> k_shortest(adjacency_list, pool);
+			STATS_PHASE(k_paths_timer, "k_shortest_paths");
+			paths = k_shortest.find(starting_vertex, target_vertex, k_paths);
+			STATS_STOP(k_paths_timer);
+		}
+
+		cout << "Shortest loopless paths from " << starting_label << " to " << target_label << ":" << endl;
+		printKPaths(paths, names);
+		if (static_cast<int>(paths.size()) < k_paths) {
+			cout << "Only " << paths.size() << " of " << k_paths << " paths exist" << endl;
+		}
+		report_stats(stats_destination, "FindPaths");
+		return 0;
+	}
+
+	// Count the edges on the paths with a breadth first search, ignoring the weights
+	if (hop_counts) {
+		ThreadPool pool(threads);
+		BreadthFirstSearch<weight_type> bfs(adjacency_list, pool);
+		BFSStats bfs_stats = bfs.run(starting_vertex);
+		printHops(bfs, names, output_order);
+		cout << "\nBreadth first search: " << bfs_stats.vertices_reached << " vertices reached in " << bfs_stats.levels
+			<< " levels, " << bfs_stats.top_down_steps << " top-down and " << bfs_stats.bottom_up_steps << " bottom-up steps" << endl;
+		report_stats(stats_destination, "FindPaths");
+		return 0;
+	}
+
+	// Only the vertices within the radius are searched, instead of the whole graph
+	if (radius >= 0) {
+		SearchWorkspace<weight_type> workspace(adjacency_list.size());
+		vector<int> reached;
+		STATS_PHASE(bounded_timer, "bounded_dijkstra");
+		bounded_dijkstra(adjacency_list, workspace, starting_vertex, WeightTraits<weight_type>::from_double(radius), reached);
+		STATS_STOP(bounded_timer);
+
+		cout << reached.size() << " vertices within cost " << radius << " of " << starting_label << ":" << endl;
+		printReached(workspace, reached, names);
+		if (bands > 0) {
+			cout << endl;
+			printIsochrones(workspace, reached, WeightTraits<weight_type>::from_double(radius), bands);
+		}
+	}
+	if (!radius_query_filename.empty()) {
+		cout << (radius >= 0 ? "\n" : "") << "Radius queries from " << radius_query_filename << ":" << endl;
+		runRadiusQueries(radius_query_filename, adjacency_list, names);
+	}
+	if (radius >= 0 || !radius_query_filename.empty()) {
+		report_stats(stats_destination, "FindPaths");
+		return 0;
+	}
+
+	// Run the Dijkstra algorithm on the graph, leaving out the vertices the components show cannot be reached
+	if (component_index) {
+		vector<char> may_reach(adjacency_list.size());
+		size_t unreachable = 0;
+		for (size_t v = 0; v < adjacency_list.size(); v++) {
+			may_reach[v] = component_index->reachability(starting_vertex, v) != Reachability::UNREACHABLE;
+			unreachable += !may_reach[v];
+		}
+		cout << unreachable << " vertices cannot be reached from " << starting_label << "\n" << endl;
+		dijkstra(starting_vertex, priority_queue, adjacency_list, &may_reach);
+	}
+	else {
+		dijkstra(starting_vertex, priority_queue, adjacency_list); 
+	}
 
 	// Print the shortest path of the vertices and their costs
-	printOutput(adjacency_list); 
+	printOutput(adjacency_list, names, output_order); 
+
+	// Apply each batch of edge changes and repair the shortest paths instead of running dijkstra() again
+	if (!update_filename.empty()) {
+		size_t batches = applyUpdates(update_filename, adjacency_list, names, starting_vertex, readers);
+		cout << "\nShortest paths after " << batches << " update batches:" << endl;
+		printOutput(adjacency_list, names, output_order);
+	}
+
+	// Print the phase times and counters if they were asked for
+	report_stats(stats_destination, "FindPaths");
 	return 0;
 }
@@ -0,0 +1,168 @@
+/*
+	Author: Vishnu Rampersaud
+	FindPaths.h header file
+	Dijkstra's algorithm and the functions that print its shortest paths
+*/
+#ifndef FIND_PATHS_H
+#define FIND_PATHS_H
+
+#include "Vertex.h"
+#include "NameTable.h"
+#include "WeightTraits.h"
+#include "Stats.h"
+#include "binary_heap.h"
+#include <iostream>
+#include <vector>
+#include <limits>
+#include <utility>
+using namespace std;
+
+// Entry in a priority queue of vertex IDs (or partition IDs) ordered by distance
+// Used by the searches that do not keep one heap entry per vertex; an entry is stale when its
+// distance is larger than the vertex's current distance, and is skipped when it comes off the heap
+template <typename Weight>
+struct QueueEntry {
+	Weight distance;
+	int id;
+
+	bool operator<(const QueueEntry& rhs) const
+	{
+		return distance < rhs.distance;
+	}
+};
+
+// Key of a QueueEntry for a HeapIndex, for heaps that do keep one entry per vertex and use decreaseKey()
+struct QueueEntryId {
+	template <typename Weight>
+	int operator()(const QueueEntry<Weight>& entry) const
+	{
+		return entry.id;
+	}
+};
+
+// Dijkstra's algorithm 
+// Finds the shortest path to all vertices in a graph 
+// @ starting_vertex: the starting vertex of where to start running the algorithm based on user input
+// @ priority_queue: a binary heap priority queue 
+// @ adjacency_list: an adjacency list that represents a graph
+// @ may_reach: if given, only the vertices marked in it are put in the priority queue; the rest are known to be
+//   unreachable (see Components.h) and are left at infinity with no path
+template <typename Weight>
+void dijkstra(int starting_vertex, BinaryHeap<Vertex<int, Weight>>& priority_queue, vector<Vertex<int, Weight>>& adjacency_list,
+	const vector<char>* may_reach = nullptr)
+{
+	STATS_PHASE(dijkstra_timer, "dijkstra");
+
+	// Make sure the priority queue is empty 
+	priority_queue.makeEmpty();
+
+	// Set a constant for infinity 
+	const Weight infinity = WeightTraits<Weight>::infinity();
+
+	// Initialize starting vertex distance and cost to 0
+	// Initialize all other Vertex distances and costs to infinity
+	// No vertex has a path yet; Then store all Vertices in the priority queue
+	for (auto itr = adjacency_list.begin(); itr != adjacency_list.end(); ++itr) {
+		if (itr->get_vertex_name() == starting_vertex) {
+			itr->setDistance(0); 
+			itr->setPath(NO_VERTEX);
+			itr->set_minPathCost(0); 
+		} 
+		else {
+			itr->setDistance(infinity);
+			itr->setPath(NO_VERTEX);
+			itr->set_minPathCost(infinity); 
+		}
+		if (may_reach == nullptr || (*may_reach)[itr->get_vertex_name()]) {
+			priority_queue.insert(*itr); 
+		}
+	}
+
+	// Run Dijkstra's algorithm until the shortest path to all vertices is found
+	while (!priority_queue.isEmpty()) {
+
+		// Delete the minimum value from the heap (smallest distance) 
+		// Store the vertex into a variable, minVertex
+		// This is the vertex with the shortest known distance
+		Vertex<int, Weight> minVertex; 
+		priority_queue.deleteMin(minVertex);
+		STATS_COUNT(vertices_settled);
+
+		// get the distance of the minimum vertex
+		Weight distance_of_minVertex = minVertex.get_distance(); 
+
+		// get the name of the minimum vertex
+		int name_of_minVertex = minVertex.get_vertex_name();
+
+		// for each vertex that is adjacent to the minimum vertex
+		for (auto edge : minVertex.adjacent()) {
+
+			// find the adjacent vertex; its ID is its index in the adjacency list
+			Vertex<int, Weight>& adjacent_vertex = adjacency_list[edge.first]; 
+			STATS_COUNT(edges_relaxed);
+
+			// get the adjacent vertex name
+			int adjacent_name = adjacent_vertex.get_vertex_name();
+			// get the adjacent vertex distance
+			Weight adjacent_distance = adjacent_vertex.get_distance(); 
+			// get the adjacent vertex edge cost/ weight
+			Weight adjacent_edge = edge.second;
+
+			// Compute a new shortest path distance for this vertex
+			// The addition stops at infinity, so it cannot overflow for integer weights
+			Weight new_distance = WeightTraits<Weight>::add(distance_of_minVertex, adjacent_edge);
+
+			// if it is smaller than the current distance, then update it with this distance 
+			if (new_distance < adjacent_distance) {
+
+				// Update the distance of the adjacent vertex 
+				adjacent_vertex.setDistance(new_distance);
+
+				// Update the path variable of this vertex to the minimum vertex
+				adjacent_vertex.setPath(name_of_minVertex); 
+
+				// Set the cost of the new shortest path of this vertex
+				adjacent_vertex.set_minPathCost(new_distance); 
+
+				// Update the distance of this adjacent vertex in the priority queue
+				Vertex<int, Weight> updateQueueValue(adjacent_name);
+				updateQueueValue.setDistance(new_distance); 
+				priority_queue.decreaseKey(updateQueueValue); 
+			}
+		}
+	}
+}
+
+// Print shortest path of specified vertex
+// Recursive algorithm 
+// @ v: print the shortest path of this vertex, v
+// @ adjacency_list: adjacency list that represents a graph
+// @ names: labels of the vertices in the graph
+template <typename Weight>
+void printPath(const Vertex<int, Weight>& v, const vector<Vertex<int, Weight>>& adjacency_list, const NameTable& names)
+{
+	if (v.getPath() != NO_VERTEX) {
+		printPath(adjacency_list[v.getPath()], adjacency_list, names); 
+		cout << ", "; 
+	}
+	cout << names.name(v.get_vertex_name()); 
+}
+
+// Print shortest path of all vertices in the graoh along with their costs
+// @ adjacency_list: adjacency list that represents a graph
+// @ names: labels of the vertices in the graph
+// @ output_order: IDs of the vertices in the order they should be printed
+template <typename Weight>
+void printOutput(const vector<Vertex<int, Weight>>& adjacency_list, const NameTable& names, const vector<int>& output_order)
+{
+	STATS_PHASE(output_timer, "output");
+	for (size_t i = 0; i < output_order.size(); i++) {
+		const Vertex<int, Weight>& v = adjacency_list[output_order[i]];
+		cout << names.name(v.get_vertex_name()) << ": "; 
+		printPath(v, adjacency_list, names); 
+		Weight cost = v.get_minPathCost(); 
+		cout << " (Cost: " << cost << ")" << endl;
+	}
+}
+
+#endif
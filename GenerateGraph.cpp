@@ -0,0 +1,287 @@
+/*
+	Author: Vishnu Rampersaud
+	Writes synthetic graph files (and adjacency query files) of any size, for benchmarking
+*/
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <random>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+using namespace std;
+
+// Kinds of graphs that can be generated
+// RANDOM: every vertex has the same number of edges to uniformly random vertices
+// GRID: a square grid with edges both ways between neighbors, like a road network
+// POWERLAW: preferential attachment; a few hub vertices have most of the edges
+// DAG: vertices split into layers, with edges only to later layers; has no cycles
+enum class GraphKind { RANDOM, GRID, POWERLAW, DAG };
+
+// @ name: name of a kind of graph, as given on the command line
+// @ kind: set to the kind with this name
+// Returns false if there is no kind with this name
+bool parse_graph_kind(const string& name, GraphKind& kind)
+{
+	if (name == "random") { kind = GraphKind::RANDOM; }
+	else if (name == "grid") { kind = GraphKind::GRID; }
+	else if (name == "powerlaw") { kind = GraphKind::POWERLAW; }
+	else if (name == "dag") { kind = GraphKind::DAG; }
+	else { return false; }
+	return true;
+}
+
+// Edges of a generated graph; edges[v] holds the (target, weight) pairs of vertex v
+typedef vector<vector<pair<int, int>>> EdgeLists;
+
+// @ n: number of vertices
+// @ degree: number of edges out of each vertex
+// @ max_weight: weights are drawn uniformly from 1 to max_weight
+// @ random: random number generator
+// Every vertex gets degree edges to random vertices other than itself
+EdgeLists random_graph(int n, int degree, int max_weight, mt19937& random)
+{
+	EdgeLists edges(n);
+	uniform_int_distribution<int> pick_vertex(0, n - 1), pick_weight(1, max_weight);
+	for (int v = 0; v < n && n > 1; v++) {
+		for (int k = 0; k < degree; k++) {
+			int w = pick_vertex(random);
+			if (w == v) { w = (w + 1) % n; }
+			edges[v].push_back(make_pair(w, pick_weight(random)));
+		}
+	}
+	return edges;
+}
+
+// @ n: number of vertices; the grid is the smallest square that holds them, with the last row cut short
+// @ max_weight: weights are drawn uniformly from 1 to max_weight
+// @ random: random number generator
+// Each vertex has an edge to its left, right, upper and lower neighbor, so the graph looks like a road map:
+// low degree, and shortest paths that are long in number of edges
+EdgeLists grid_graph(int n, int max_weight, mt19937& random)
+{
+	EdgeLists edges(n);
+	const int side = max(1, static_cast<int>(ceil(sqrt(static_cast<double>(n)))));
+	uniform_int_distribution<int> pick_weight(1, max_weight);
+	for (int v = 0; v < n; v++) {
+		const int row = v / side, column = v % side;
+		const int neighbors[4] = { column > 0 ? v - 1 : -1, column + 1 < side ? v + 1 : -1,
+			row > 0 ? v - side : -1, v + side };
+		for (int k = 0; k < 4; k++) {
+			if (neighbors[k] >= 0 && neighbors[k] < n) {
+				edges[v].push_back(make_pair(neighbors[k], pick_weight(random)));
+			}
+		}
+	}
+	return edges;
+}
+
+// @ n: number of vertices
+// @ degree: number of edges each new vertex adds
+// @ max_weight: weights are drawn uniformly from 1 to max_weight
+// @ random: random number generator
+// Preferential attachment (Barabasi-Albert): each new vertex is joined to degree earlier vertices,
+// picked with probability proportional to their degree so far. Each edge gets a random direction,
+// so both the indegree and the outdegree follow a power law and the graph has cycles
+EdgeLists powerlaw_graph(int n, int degree, int max_weight, mt19937& random)
+{
+	EdgeLists edges(n);
+	uniform_int_distribution<int> pick_weight(1, max_weight), pick_direction(0, 1);
+
+	// Each edge adds both of its ends here, so picking a random entry picks a vertex by degree
+	vector<int> endpoints;
+	endpoints.reserve(2 * static_cast<size_t>(n) * degree);
+	for (int v = 1; v < n; v++) {
+		// Only the entries of earlier vertices are picked from, so v is never joined to itself
+		const size_t earlier = endpoints.size();
+		for (int k = 0; k < degree; k++) {
+			int w = earlier == 0 ? 0 : endpoints[uniform_int_distribution<size_t>(0, earlier - 1)(random)];
+			if (pick_direction(random)) {
+				edges[v].push_back(make_pair(w, pick_weight(random)));
+			}
+			else {
+				edges[w].push_back(make_pair(v, pick_weight(random)));
+			}
+			endpoints.push_back(v);
+			endpoints.push_back(w);
+		}
+	}
+	return edges;
+}
+
+// @ n: number of vertices
+// @ degree: number of edges out of each vertex that is not in the last layer
+// @ layers: number of layers
+// @ max_weight: weights are drawn uniformly from 1 to max_weight
+// @ random: random number generator
+// Vertices are split into layers of equal size; every edge goes from a layer to one of the next
+// three layers, so the graph has no cycles and topological sort always succeeds
+EdgeLists dag_graph(int n, int degree, int layers, int max_weight, mt19937& random)
+{
+	EdgeLists edges(n);
+	layers = max(1, min(layers, n));
+	const int layer_size = (n + layers - 1) / layers;
+	uniform_int_distribution<int> pick_weight(1, max_weight), pick_layer(1, 3);
+	for (int v = 0; v < n; v++) {
+		const int layer = v / layer_size;
+		for (int k = 0; k < degree; k++) {
+			const int first = (layer + pick_layer(random)) * layer_size;
+			if (first >= n) { continue; }
+			const int last = min(n, first + layer_size) - 1;
+			edges[v].push_back(make_pair(uniform_int_distribution<int>(first, last)(random), pick_weight(random)));
+		}
+	}
+	return edges;
+}
+
+// @ filename: name of the graph file to write
+// @ edges: edges of the graph
+// @ labels: labels[v] is the label written for vertex v
+// Writes the graph in the format read by createAdjacencyList(): the number of vertices,
+// then one line per vertex, in order of label, with its label followed by (adjacent vertex, weight) pairs
+bool write_graph(const string& filename, const EdgeLists& edges, const vector<int>& labels)
+{
+	ofstream file(filename);
+	if (!file.is_open()) {
+		return false;
+	}
+	vector<int> by_label(edges.size());
+	for (size_t v = 0; v < edges.size(); v++) {
+		by_label[labels[v] - 1] = v;
+	}
+
+	file << edges.size() << "\n";
+	string line;
+	for (size_t i = 0; i < by_label.size(); i++) {
+		const int v = by_label[i];
+		line = to_string(labels[v]);
+		for (size_t k = 0; k < edges[v].size(); k++) {
+			line += ' ';
+			line += to_string(labels[edges[v][k].first]);
+			line += ' ';
+			line += to_string(edges[v][k].second);
+		}
+		line += '\n';
+		file << line;
+	}
+	return static_cast<bool>(file);
+}
+
+// @ filename: name of the adjacency query file to write
+// @ edges: edges of the graph
+// @ labels: labels[v] is the label written for vertex v
+// @ count: number of queries to write
+// @ random: random number generator
+// Writes queries for CreateGraphAndTest; half of them are edges of the graph and half are random pairs,
+// which are almost always not connected
+bool write_queries(const string& filename, const EdgeLists& edges, const vector<int>& labels, int count, mt19937& random)
+{
+	ofstream file(filename);
+	if (!file.is_open()) {
+		return false;
+	}
+	const int n = edges.size();
+	uniform_int_distribution<int> pick_vertex(0, n - 1);
+	for (int q = 0; q < count && n > 0; q++) {
+		int v = pick_vertex(random), w = pick_vertex(random);
+		if (q % 2 == 0 && !edges[v].empty()) {
+			w = edges[v][uniform_int_distribution<size_t>(0, edges[v].size() - 1)(random)].first;
+		}
+		file << labels[v] << " " << labels[w] << "\n";
+	}
+	return static_cast<bool>(file);
+}
+
+int main(int argc, char** argv)
+{
+	// Checks to see if the correct number of arguments are entered
+	const string usage = string("Usage: ") + argv[0] + " random|grid|powerlaw|dag <VERTICES> <GRAPH_FILE>"
+		+ " [--degree=<EDGES>] [--layers=<LAYERS>] [--max-weight=<WEIGHT>] [--seed=<SEED>]"
+		+ " [--queries=<QUERY_FILE>] [--query-count=<QUERIES>]";
+	GraphKind kind;
+	if (argc < 4 || !parse_graph_kind(argv[1], kind) || atoi(argv[2]) <= 0) {
+		cout << usage << endl;
+		return 0;
+	}
+
+	// Store arguments into variables
+	const int n = atoi(argv[2]);
+	const string graph_filename(argv[3]);
+
+	// Read the options that follow the required arguments
+	int degree = 4;
+	int layers = max(1, static_cast<int>(sqrt(static_cast<double>(n))));
+	int max_weight = 100;
+	unsigned seed = 1;
+	string query_filename;
+	int query_count = 1000;
+	for (int i = 4; i < argc; i++) {
+		const string option(argv[i]);
+		if (option.compare(0, 9, "--degree=") == 0 && atoi(option.c_str() + 9) > 0) {
+			degree = atoi(option.c_str() + 9);
+			continue;
+		}
+		if (option.compare(0, 9, "--layers=") == 0 && atoi(option.c_str() + 9) > 0) {
+			layers = atoi(option.c_str() + 9);
+			continue;
+		}
+		if (option.compare(0, 13, "--max-weight=") == 0 && atoi(option.c_str() + 13) > 0) {
+			max_weight = atoi(option.c_str() + 13);
+			continue;
+		}
+		if (option.compare(0, 7, "--seed=") == 0) {
+			seed = strtoul(option.c_str() + 7, nullptr, 10);
+			continue;
+		}
+		if (option.compare(0, 10, "--queries=") == 0 && option.size() > 10) {
+			query_filename = option.substr(10);
+			continue;
+		}
+		if (option.compare(0, 14, "--query-count=") == 0 && atoi(option.c_str() + 14) > 0) {
+			query_count = atoi(option.c_str() + 14);
+			continue;
+		}
+		cout << "Unknown option: " << option << endl;
+		cout << usage << endl;
+		return 0;
+	}
+
+	mt19937 random(seed);
+	EdgeLists edges;
+	switch (kind) {
+	case GraphKind::GRID: edges = grid_graph(n, max_weight, random); break;
+	case GraphKind::POWERLAW: edges = powerlaw_graph(n, degree, max_weight, random); break;
+	case GraphKind::DAG: edges = dag_graph(n, degree, layers, max_weight, random); break;
+	default: edges = random_graph(n, degree, max_weight, random); break;
+	}
+
+	// Label the vertices 1 to n in a random order; the file lists them by label, so the file order says
+	// nothing about the structure (e.g. a DAG is not already written in topological order)
+	vector<int> labels(n);
+	for (int v = 0; v < n; v++) {
+		labels[v] = v + 1;
+	}
+	shuffle(labels.begin(), labels.end(), random);
+
+	if (!write_graph(graph_filename, edges, labels)) {
+		cout << "Could not write " << graph_filename << endl;
+		return 1;
+	}
+	size_t number_of_edges = 0;
+	for (int v = 0; v < n; v++) {
+		number_of_edges += edges[v].size();
+	}
+	cout << "Wrote " << graph_filename << ": " << n << " vertices, " << number_of_edges << " edges" << endl;
+
+	if (!query_filename.empty()) {
+		if (!write_queries(query_filename, edges, labels, query_count, random)) {
+			cout << "Could not write " << query_filename << endl;
+			return 1;
+		}
+		cout << "Wrote " << query_filename << ": " << query_count << " adjacency queries" << endl;
+	}
+
+	return 0;
+}
@@ -0,0 +1,384 @@
+/*
+	Author: Vishnu Rampersaud
+	GraphSnapshot.h header file
+	Versioned copy on write storage of a graph, so queries can read a fixed version of the graph
+	while a writer applies edge changes
+*/
+#ifndef GRAPH_SNAPSHOT_H
+#define GRAPH_SNAPSHOT_H
+
+#include "Vertex.h"
+#include "WeightTraits.h"
+#include "FindPaths.h"
+#include "DynamicPaths.h"
+#include "binary_heap.h"
+#include <vector>
+#include <map>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <cstdint>
+#include <utility>
+using namespace std;
+
+// How the versions work
+//
+// The adjacency lists are split into blocks of consecutive vertices. A version of the graph is an array of
+// pointers to blocks, and blocks are never changed once a version that uses them is published. A batch of
+// edge changes copies only the blocks it touches, so the new version shares every other block with the old one.
+//
+// Readers take no locks. A reader pins the current version by writing the current epoch into a free reader
+// slot, and then reading the pointer to the current version. The writer publishes a new version by swapping
+// that pointer, and stamps the old version with the epoch at the time of the swap before advancing the epoch.
+// A reader that pinned at a later epoch can only have seen the new version, so the old version (and any block
+// only it uses) is freed once every pinned reader has a later epoch than the stamp.
+
+// AdjacencyBlock class
+// The adjacency lists of a run of consecutive vertices in compressed row form: the edges of the i-th vertex
+// of the block are edges[first[i]] up to edges[first[i + 1]]
+template <typename Weight>
+struct AdjacencyBlock {
+	vector<uint32_t> first;
+	vector<pair<int, Weight>> edges;
+
+	// Number of versions that use this block; only read and written by the writer
+	int references;
+};
+
+// One version of the graph
+template <typename Weight>
+struct GraphVersion {
+	unsigned long long number;
+	vector<AdjacencyBlock<Weight>*> blocks;
+
+	// Epoch when the version was replaced; set by the writer
+	unsigned long long retired_epoch;
+};
+
+template <typename Weight>
+class GraphSnapshot;
+
+// VersionedGraph class
+// Holds the versions of a graph; any number of threads can read snapshots while one thread at a time
+// applies batches of edge changes. The set of vertices does not change.
+template <typename Weight>
+class VersionedGraph {
+public:
+
+	// Number of snapshots that can be held at the same time; further readers wait for a free slot
+	static const int MAX_READERS = 64;
+
+	// @ adjacency_list: the graph to start from; it becomes version 0
+	// @ vertices_per_block: number of vertices whose adjacency lists are copied together
+	VersionedGraph(const vector<Vertex<int, Weight>>& adjacency_list, int vertices_per_block = 256)
+		: vertices_per_block(vertices_per_block), number_of_vertices(adjacency_list.size()), global_epoch(1),
+		  versions_published(0), versions_reclaimed(0), blocks_copied(0)
+	{
+		for (int slot = 0; slot < MAX_READERS; slot++) {
+			reader_epochs[slot].store(0);
+		}
+
+		GraphVersion<Weight>* version = new GraphVersion<Weight>();
+		version->number = 0;
+		version->retired_epoch = 0;
+		for (int first_vertex = 0; first_vertex < number_of_vertices; first_vertex += vertices_per_block) {
+			const int last_vertex = min(number_of_vertices, first_vertex + vertices_per_block);
+			AdjacencyBlock<Weight>* block = new AdjacencyBlock<Weight>();
+			block->references = 1;
+			block->first.push_back(0);
+			for (int v = first_vertex; v < last_vertex; v++) {
+				for (auto edge : adjacency_list[v].adjacent()) {
+					block->edges.push_back(edge);
+				}
+				block->first.push_back(block->edges.size());
+			}
+			version->blocks.push_back(block);
+		}
+		current.store(version);
+	}
+
+	// Destructor that frees every version; no snapshot may still be held
+	~VersionedGraph()
+	{
+		retired.push_back(current.load());
+		for (size_t i = 0; i < retired.size(); i++) {
+			free_version(retired[i]);
+		}
+	}
+
+	VersionedGraph(const VersionedGraph&) = delete;
+	VersionedGraph& operator=(const VersionedGraph&) = delete;
+
+	// @ batch: the edge changes to make, in order (see DynamicPaths.h for their meaning)
+	// Builds and publishes a new version with the changes; readers that already hold a snapshot keep seeing
+	// the old version. Only the blocks of the vertices whose edges change are copied.
+	// Returns the number of the new version
+	unsigned long long apply(const vector<EdgeChange<Weight>>& batch)
+	{
+		lock_guard<mutex> writer(writer_lock);
+		GraphVersion<Weight>* old_version = current.load();
+
+		// Unpack each block that has a change into plain lists, and make the changes there
+		map<int, vector<vector<pair<int, Weight>>>> changed_blocks;
+		for (size_t i = 0; i < batch.size(); i++) {
+			const EdgeChange<Weight>& change = batch[i];
+			const int b = change.from / vertices_per_block;
+			typename map<int, vector<vector<pair<int, Weight>>>>::iterator lists = changed_blocks.find(b);
+			if (lists == changed_blocks.end()) {
+				lists = changed_blocks.insert(make_pair(b, unpack(*old_version->blocks[b]))).first;
+			}
+			vector<pair<int, Weight>>& edges = lists->second[change.from % vertices_per_block];
+
+			size_t k = 0;
+			while (k < edges.size() && edges[k].first != change.to) {
+				k++;
+			}
+			if (change.kind == EdgeChangeKind::DELETE) {
+				if (k < edges.size()) { edges.erase(edges.begin() + k); }
+			}
+			else if (k < edges.size()) {
+				edges[k].second = change.weight;
+			}
+			else if (change.kind == EdgeChangeKind::INSERT) {
+				edges.push_back(make_pair(change.to, change.weight));
+			}
+		}
+
+		// The new version shares every block without a change
+		GraphVersion<Weight>* new_version = new GraphVersion<Weight>();
+		new_version->number = old_version->number + 1;
+		new_version->retired_epoch = 0;
+		new_version->blocks = old_version->blocks;
+		for (size_t b = 0; b < new_version->blocks.size(); b++) {
+			new_version->blocks[b]->references++;
+		}
+		for (typename map<int, vector<vector<pair<int, Weight>>>>::iterator lists = changed_blocks.begin();
+			lists != changed_blocks.end(); ++lists) {
+			new_version->blocks[lists->first]->references--;
+			new_version->blocks[lists->first] = pack(lists->second);
+			blocks_copied++;
+		}
+
+		// Publish the new version, then stamp the old one with the epoch of the swap
+		current.store(new_version);
+		old_version->retired_epoch = global_epoch.fetch_add(1);
+		retired.push_back(old_version);
+		versions_published++;
+
+		reclaim_versions();
+		return new_version->number;
+	}
+
+	// Frees the replaced versions that no reader can still be using
+	// Returns the number of versions freed
+	size_t reclaim()
+	{
+		lock_guard<mutex> writer(writer_lock);
+		return reclaim_versions();
+	}
+
+	int vertex_count() const
+	{
+		return number_of_vertices;
+	}
+
+	// Returns the number of the current version
+	unsigned long long current_version() const
+	{
+		return current.load()->number;
+	}
+
+	// Counters of the work the writer has done
+	unsigned long long published() const { return versions_published; }
+	unsigned long long reclaimed() const { return versions_reclaimed; }
+	unsigned long long copied_blocks() const { return blocks_copied; }
+
+private:
+	friend class GraphSnapshot<Weight>;
+
+	const int vertices_per_block;
+	const int number_of_vertices;
+
+	// The version new snapshots see
+	atomic<GraphVersion<Weight>*> current;
+
+	// Advanced every time a version is replaced; starts at 1, because 0 marks a free reader slot
+	atomic<unsigned long long> global_epoch;
+
+	// The epoch each reader pinned its snapshot at, or 0 for a free slot
+	atomic<unsigned long long> reader_epochs[MAX_READERS];
+
+	// Versions that have been replaced but may still be read; only used by the writer
+	vector<GraphVersion<Weight>*> retired;
+	mutex writer_lock;
+
+	unsigned long long versions_published, versions_reclaimed, blocks_copied;
+
+	// Claims a reader slot and records the current epoch in it; returns the slot
+	int pin()
+	{
+		for (;;) {
+			for (int slot = 0; slot < MAX_READERS; slot++) {
+				unsigned long long free_slot = 0;
+				if (reader_epochs[slot].load() == 0
+					&& reader_epochs[slot].compare_exchange_strong(free_slot, global_epoch.load())) {
+					return slot;
+				}
+			}
+			this_thread::yield();
+		}
+	}
+
+	// Releases a reader slot
+	void unpin(int slot)
+	{
+		reader_epochs[slot].store(0);
+	}
+
+	// Frees the retired versions whose epoch is older than that of every pinned reader
+	size_t reclaim_versions()
+	{
+		unsigned long long oldest_reader = global_epoch.load();
+		for (int slot = 0; slot < MAX_READERS; slot++) {
+			unsigned long long epoch = reader_epochs[slot].load();
+			if (epoch != 0 && epoch < oldest_reader) {
+				oldest_reader = epoch;
+			}
+		}
+
+		size_t freed = 0, kept = 0;
+		for (size_t i = 0; i < retired.size(); i++) {
+			if (retired[i]->retired_epoch < oldest_reader) {
+				free_version(retired[i]);
+				freed++;
+			}
+			else {
+				retired[kept++] = retired[i];
+			}
+		}
+		retired.resize(kept);
+		versions_reclaimed += freed;
+		return freed;
+	}
+
+	// Frees a version and every block that no other version uses
+	void free_version(GraphVersion<Weight>* version)
+	{
+		for (size_t b = 0; b < version->blocks.size(); b++) {
+			if (--version->blocks[b]->references == 0) {
+				delete version->blocks[b];
+			}
+		}
+		delete version;
+	}
+
+	// Returns the adjacency lists of a block as one list per vertex
+	vector<vector<pair<int, Weight>>> unpack(const AdjacencyBlock<Weight>& block) const
+	{
+		vector<vector<pair<int, Weight>>> lists(block.first.size() - 1);
+		for (size_t i = 0; i < lists.size(); i++) {
+			lists[i].assign(block.edges.begin() + block.first[i], block.edges.begin() + block.first[i + 1]);
+		}
+		return lists;
+	}
+
+	// Returns a new block holding the adjacency lists
+	AdjacencyBlock<Weight>* pack(const vector<vector<pair<int, Weight>>>& lists) const
+	{
+		AdjacencyBlock<Weight>* block = new AdjacencyBlock<Weight>();
+		block->references = 1;
+		block->first.push_back(0);
+		for (size_t i = 0; i < lists.size(); i++) {
+			block->edges.insert(block->edges.end(), lists[i].begin(), lists[i].end());
+			block->first.push_back(block->edges.size());
+		}
+		return block;
+	}
+};
+
+// GraphSnapshot class
+// A pinned version of a VersionedGraph; it does not change while the snapshot exists, whatever the writer does
+// Hold a snapshot only as long as a query needs it, since replaced versions cannot be freed while it is held
+template <typename Weight>
+class GraphSnapshot {
+public:
+
+	// @ graph: the graph to read
+	// Constructor that pins the current version
+	explicit GraphSnapshot(VersionedGraph<Weight>& graph)
+		: graph(graph), slot(graph.pin()), version_(graph.current.load())
+	{
+	}
+
+	// Destructor that releases the version
+	~GraphSnapshot()
+	{
+		graph.unpin(slot);
+	}
+
+	GraphSnapshot(const GraphSnapshot&) = delete;
+	GraphSnapshot& operator=(const GraphSnapshot&) = delete;
+
+	// Returns the number of the version this snapshot reads
+	unsigned long long version() const
+	{
+		return version_->number;
+	}
+
+	int vertex_count() const
+	{
+		return graph.vertex_count();
+	}
+
+	// @ v: ID of a vertex
+	// Returns the adjacent vertices of v and their weights in this version
+	AdjacencyRange<int, Weight> adjacent(int v) const
+	{
+		const AdjacencyBlock<Weight>& block = *version_->blocks[v / graph.vertices_per_block];
+		const int i = v % graph.vertices_per_block;
+		const pair<int, Weight>* edges = block.edges.data();
+		return AdjacencyRange<int, Weight>(AdjacencyIterator<int, Weight>(edges + block.first[i]),
+			AdjacencyIterator<int, Weight>(edges + block.first[i + 1]));
+	}
+
+private:
+	VersionedGraph<Weight>& graph;
+	const int slot;
+	const GraphVersion<Weight>* version_;
+};
+
+// Dijkstra's algorithm on a snapshot
+// @ snapshot: the version of the graph to search
+// @ starting_vertex: ID of the starting vertex
+// @ distance: receives the cost of the shortest path to each vertex (infinity if unreachable)
+// @ path: receives the previous vertex on the shortest path to each vertex (NO_VERTEX for none)
+// The vertices in the snapshot are read only, so the costs and paths are returned in the arrays
+template <typename Weight>
+void snapshot_dijkstra(const GraphSnapshot<Weight>& snapshot, int starting_vertex, vector<Weight>& distance, vector<int>& path)
+{
+	const int n = snapshot.vertex_count();
+	distance.assign(n, WeightTraits<Weight>::infinity());
+	path.assign(n, NO_VERTEX);
+
+	BinaryHeap<QueueEntry<Weight>> priority_queue;
+	QueueEntry<Weight> entry = { 0, starting_vertex };
+	distance[starting_vertex] = 0;
+	priority_queue.insert(entry);
+	while (!priority_queue.isEmpty()) {
+		QueueEntry<Weight> top;
+		priority_queue.deleteMin(top);
+		if (top.distance != distance[top.id]) { continue; }
+
+		for (auto edge : snapshot.adjacent(top.id)) {
+			Weight new_distance = WeightTraits<Weight>::add(top.distance, edge.second);
+			if (new_distance < distance[edge.first]) {
+				distance[edge.first] = new_distance;
+				path[edge.first] = top.id;
+				QueueEntry<Weight> relaxed = { new_distance, edge.first };
+				priority_queue.insert(relaxed);
+			}
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,243 @@
+/*
+	Author: Vishnu Rampersaud
+	KShortestPaths.h header file
+	Yen's algorithm for the k shortest loopless paths between two vertices, with the spur searches
+	of each round run in parallel
+*/
+#ifndef K_SHORTEST_PATHS_H
+#define K_SHORTEST_PATHS_H
+
+#include "Vertex.h"
+#include "NameTable.h"
+#include "WeightTraits.h"
+#include "SearchWorkspace.h"
+#include "ThreadPool.h"
+#include "Stats.h"
+#include <iostream>
+#include <vector>
+#include <set>
+#include <utility>
+#include <algorithm>
+using namespace std;
+
+// A path from a source vertex; costs[i] is the cost of the path up to vertices[i]
+template <typename Weight>
+struct WeightedPath {
+	vector<int> vertices;
+	vector<Weight> costs;
+
+	Weight cost() const
+	{
+		return costs.back();
+	}
+
+	// Orders paths by cost, and paths of equal cost by their vertices, so the result does not
+	// depend on which thread found a path first
+	bool operator<(const WeightedPath& rhs) const
+	{
+		if (cost() != rhs.cost()) {
+			return cost() < rhs.cost();
+		}
+		return vertices < rhs.vertices;
+	}
+};
+
+// KShortestPaths class
+// Yen's algorithm: the first path is the shortest path; every later path leaves one of the paths found
+// so far at some vertex (the spur vertex) and takes the shortest way to the target from there that
+// does not reuse the part before the spur vertex (the root) or an edge that an earlier path with the
+// same root took out of the spur vertex. Each round searches from every spur vertex of the last path
+// found; these searches are independent, so they run in parallel on a thread pool.
+//
+// Removing vertices and edges is done with a bitset per thread over the vertex IDs and the edge IDs
+// (the position of an edge in the adjacency lists), so the graph itself is shared and never copied.
+template <typename Weight>
+class KShortestPaths {
+public:
+
+	// @ adjacency_list: the graph to search; it is only read
+	// @ pool: threads to run the spur searches on
+	KShortestPaths(const vector<Vertex<int, Weight>>& adjacency_list, ThreadPool& pool)
+		: adjacency_list(adjacency_list), pool(pool), edge_offset(adjacency_list.size() + 1, 0)
+	{
+		for (size_t v = 0; v < adjacency_list.size(); v++) {
+			edge_offset[v + 1] = edge_offset[v] + adjacency_list[v].adjacent_count();
+		}
+		for (int t = 0; t < pool.size(); t++) {
+			buffers.push_back(SpurBuffers(adjacency_list.size(), edge_offset.back()));
+		}
+	}
+
+	// @ source: ID of the first vertex of the paths
+	// @ target: ID of the last vertex of the paths
+	// @ k: number of paths to find
+	// Returns up to k loopless paths from source to target, shortest first; fewer if there are not k of them
+	vector<WeightedPath<Weight>> find(int source, int target, int k)
+	{
+		vector<WeightedPath<Weight>> paths;
+		if (k <= 0) {
+			return paths;
+		}
+		WeightedPath<Weight> shortest;
+		if (!search(buffers[0], source, target, shortest)) {
+			return paths;
+		}
+		paths.push_back(shortest);
+
+		// Paths found by spur searches but not yet taken; seen holds every path ever found, to skip repeats
+		set<WeightedPath<Weight>> candidates;
+		set<vector<int>> seen;
+		seen.insert(shortest.vertices);
+
+		while (static_cast<int>(paths.size()) < k) {
+			const WeightedPath<Weight>& last = paths.back();
+			const size_t spur_count = last.vertices.size() - 1;
+			vector<WeightedPath<Weight>> spur_paths(spur_count);
+			vector<char> found(spur_count, 0);
+
+			pool.parallel_for(spur_count, [&](size_t i, int thread) {
+				found[i] = spur(buffers[thread], paths, i, target, spur_paths[i]);
+			});
+
+			for (size_t i = 0; i < spur_count; i++) {
+				if (found[i] && seen.insert(spur_paths[i].vertices).second) {
+					candidates.insert(spur_paths[i]);
+				}
+			}
+			if (candidates.empty()) {
+				break;
+			}
+			paths.push_back(*candidates.begin());
+			candidates.erase(candidates.begin());
+		}
+		return paths;
+	}
+
+private:
+
+	// The search state and removed vertices and edges of one thread
+	struct SpurBuffers {
+		SearchWorkspace<Weight> search;
+		BitMask removed_vertices;
+		BitMask removed_edges;
+
+		SpurBuffers(size_t vertices, size_t edges) : search(vertices), removed_vertices(vertices), removed_edges(edges)
+		{
+		}
+	};
+
+	const vector<Vertex<int, Weight>>& adjacency_list;
+	ThreadPool& pool;
+
+	// The edges of vertex v have IDs edge_offset[v] up to edge_offset[v + 1], in adjacency list order
+	vector<size_t> edge_offset;
+
+	// One set of buffers per thread
+	vector<SpurBuffers> buffers;
+
+	// @ buffers: the calling thread's buffers, with the removed vertices and edges set
+	// @ source, target: IDs of the ends of the path
+	// @ path: receives the path
+	// Dijkstra's algorithm from source that skips the removed vertices and edges, and stops at target
+	// Returns false if target cannot be reached
+	bool search(SpurBuffers& buffers, int source, int target, WeightedPath<Weight>& path)
+	{
+		SearchWorkspace<Weight>& workspace = buffers.search;
+		workspace.reset();
+		workspace.improve(source, 0, NO_VERTEX);
+
+		QueueEntry<Weight> top;
+		bool reached = false;
+		while (workspace.next(top)) {
+			STATS_COUNT(vertices_settled);
+			if (top.id == target) {
+				reached = true;
+				break;
+			}
+			size_t edge_id = edge_offset[top.id];
+			for (auto edge : adjacency_list[top.id].adjacent()) {
+				if (!buffers.removed_edges.test(edge_id++) && !buffers.removed_vertices.test(edge.first)) {
+					STATS_COUNT(edges_relaxed);
+					workspace.improve(edge.first, WeightTraits<Weight>::add(top.distance, edge.second), top.id);
+				}
+			}
+		}
+		if (!reached) {
+			return false;
+		}
+
+		path.vertices.clear();
+		path.costs.clear();
+		for (int v = target; v != NO_VERTEX; v = workspace.path(v)) {
+			path.vertices.push_back(v);
+			path.costs.push_back(workspace.distance(v));
+		}
+		reverse(path.vertices.begin(), path.vertices.end());
+		reverse(path.costs.begin(), path.costs.end());
+		return true;
+	}
+
+	// @ buffers: the calling thread's buffers
+	// @ paths: the paths found so far
+	// @ i: position of the spur vertex in the last path
+	// @ target: ID of the last vertex of the paths
+	// @ path: receives the root of the last path up to the spur vertex, followed by the spur path
+	// Returns false if there is no spur path from this spur vertex
+	bool spur(SpurBuffers& buffers, const vector<WeightedPath<Weight>>& paths, size_t i, int target, WeightedPath<Weight>& path)
+	{
+		const WeightedPath<Weight>& last = paths.back();
+		const int spur_vertex = last.vertices[i];
+		buffers.removed_vertices.clear();
+		buffers.removed_edges.clear();
+
+		// Paths that share this root may not leave the spur vertex the same way again
+		for (size_t p = 0; p < paths.size(); p++) {
+			const vector<int>& vertices = paths[p].vertices;
+			if (vertices.size() <= i + 1 || !equal(vertices.begin(), vertices.begin() + i + 1, last.vertices.begin())) {
+				continue;
+			}
+			size_t edge_id = edge_offset[spur_vertex];
+			for (auto edge : adjacency_list[spur_vertex].adjacent()) {
+				if (edge.first == vertices[i + 1]) {
+					buffers.removed_edges.set(edge_id);
+				}
+				edge_id++;
+			}
+		}
+
+		// The spur path may not go back through the root
+		for (size_t r = 0; r < i; r++) {
+			buffers.removed_vertices.set(last.vertices[r]);
+		}
+
+		WeightedPath<Weight> spur_path;
+		if (!search(buffers, spur_vertex, target, spur_path)) {
+			return false;
+		}
+		path.vertices.assign(last.vertices.begin(), last.vertices.begin() + i);
+		path.costs.assign(last.costs.begin(), last.costs.begin() + i);
+		for (size_t s = 0; s < spur_path.vertices.size(); s++) {
+			path.vertices.push_back(spur_path.vertices[s]);
+			path.costs.push_back(WeightTraits<Weight>::add(last.costs[i], spur_path.costs[s]));
+		}
+		return true;
+	}
+};
+
+// @ paths: paths from the search
+// @ names: labels of the vertices in the graph
+// Prints each path with its rank and cost
+template <typename Weight>
+void printKPaths(const vector<WeightedPath<Weight>>& paths, const NameTable& names)
+{
+	STATS_PHASE(output_timer, "output");
+	for (size_t p = 0; p < paths.size(); p++) {
+		cout << p + 1 << ": ";
+		for (size_t i = 0; i < paths[p].vertices.size(); i++) {
+			cout << (i == 0 ? "" : ", ") << names.name(paths[p].vertices[i]);
+		}
+		cout << " (Cost: " << paths[p].cost() << ")" << endl;
+	}
+}
+
+#endif
@@ -0,0 +1,216 @@
+/*
+	Author: Vishnu Rampersaud
+	NameTable.h header file for the NameTable class
+*/
+#ifndef NAME_TABLE_H
+#define NAME_TABLE_H
+
+#include <string>
+#include <vector>
+#include <cstring>
+#include <cstdint>
+#include <cstdlib>
+#include <algorithm>
+#include <utility>
+using namespace std;
+
+// ID used to mean "no vertex", e.g. the path of a vertex that has no predecessor
+const int NO_VERTEX = -1;
+
+// NameTable class
+// Interns the vertex labels of a graph file and maps each distinct label to a dense ID (0, 1, 2, ...)
+// The algorithms only work with these IDs; labels are only needed again when printing output
+//
+// Labels are stored back to back in one character arena, and looked up through an
+// open addressing (linear probing) hash table, so no string objects are allocated per vertex
+class NameTable {
+public:
+
+	// @ expected_names: number of labels the table should hold without growing
+	// Constructor that sizes the hash table for the expected number of labels
+	explicit NameTable(int expected_names = 16)
+		: offsets(1, 0), slots(table_size_for(expected_names), NO_VERTEX)
+	{
+		hashes.reserve(expected_names);
+		offsets.reserve(expected_names + 1);
+	}
+
+	// @ label: the label of a vertex
+	// Returns the ID of the label, assigning it the next free ID if it has not been seen before
+	int intern(const string& label)
+	{
+		return intern(label.data(), label.size());
+	}
+
+	// @ label: pointer to the first character of the label
+	// @ length: number of characters in the label
+	// Returns the ID of the label, assigning it the next free ID if it has not been seen before
+	int intern(const char* label, size_t length)
+	{
+		uint32_t hash = hash_label(label, length);
+		size_t slot = find_slot(label, length, hash);
+		if (slots[slot] != NO_VERTEX) {
+			return slots[slot];
+		}
+
+		// New label; copy it into the arena and give it the next ID
+		int id = size();
+		arena.insert(arena.end(), label, label + length);
+		offsets.push_back(arena.size());
+		hashes.push_back(hash);
+		slots[slot] = id;
+
+		// Keep the load factor at or below one half so probe sequences stay short
+		if (2 * hashes.size() > slots.size()) {
+			grow();
+		}
+		return id;
+	}
+
+	// @ label: the label of a vertex
+	// Returns the ID of the label, or NO_VERTEX if the label is not in the table
+	int find(const string& label) const
+	{
+		return slots[find_slot(label.data(), label.size(), hash_label(label.data(), label.size()))];
+	}
+
+	// @ id: ID of a vertex
+	// Returns the label that was interned with this ID
+	string name(int id) const
+	{
+		return string(arena.data() + offsets[id], offsets[id + 1] - offsets[id]);
+	}
+
+	// Returns the number of distinct labels in the table
+	int size() const
+	{
+		return hashes.size();
+	}
+
+	// @ new_id: new_id[id] is the ID the label with this ID should have from now on; must be a permutation
+	// Renumbers the labels, e.g. after the vertices of the graph have been reordered
+	void relabel(const vector<int>& new_id)
+	{
+		vector<int> old_id(size());
+		for (int id = 0; id < size(); id++) {
+			old_id[new_id[id]] = id;
+		}
+
+		// Copy the labels into a new arena in their new order
+		vector<char> new_arena;
+		new_arena.reserve(arena.size());
+		vector<size_t> new_offsets(1, 0);
+		new_offsets.reserve(offsets.size());
+		vector<uint32_t> new_hashes;
+		new_hashes.reserve(hashes.size());
+		for (int id = 0; id < size(); id++) {
+			int old = old_id[id];
+			new_arena.insert(new_arena.end(), arena.begin() + offsets[old], arena.begin() + offsets[old + 1]);
+			new_offsets.push_back(new_arena.size());
+			new_hashes.push_back(hashes[old]);
+		}
+		arena.swap(new_arena);
+		offsets.swap(new_offsets);
+		hashes.swap(new_hashes);
+
+		// Slots still hold the old IDs
+		for (size_t slot = 0; slot < slots.size(); slot++) {
+			if (slots[slot] != NO_VERTEX) {
+				slots[slot] = new_id[slots[slot]];
+			}
+		}
+	}
+
+private:
+
+	// Holds the characters of every label, one after another
+	vector<char> arena;
+
+	// Label with ID i occupies arena[offsets[i]] up to arena[offsets[i + 1]]
+	vector<size_t> offsets;
+
+	// Hash of each label by ID; kept so the table can grow without rehashing the labels
+	vector<uint32_t> hashes;
+
+	// Open addressing hash table; each slot holds an ID or NO_VERTEX if it is empty
+	vector<int> slots;
+
+	// Returns the smallest power of two that keeps the load factor at or below one half
+	static size_t table_size_for(int expected_names)
+	{
+		size_t size = 16;
+		while (size < 2 * static_cast<size_t>(expected_names)) {
+			size *= 2;
+		}
+		return size;
+	}
+
+	// FNV-1a hash of a label
+	static uint32_t hash_label(const char* label, size_t length)
+	{
+		uint32_t hash = 2166136261u;
+		for (size_t i = 0; i < length; i++) {
+			hash ^= static_cast<unsigned char>(label[i]);
+			hash *= 16777619u;
+		}
+		return hash;
+	}
+
+	// Returns the slot that holds the label, or the empty slot where it would be inserted
+	size_t find_slot(const char* label, size_t length, uint32_t hash) const
+	{
+		size_t mask = slots.size() - 1;
+		for (size_t slot = hash & mask; ; slot = (slot + 1) & mask) {
+			int id = slots[slot];
+			if (id == NO_VERTEX) {
+				return slot;
+			}
+			// Compare the stored hash first so most mismatches never touch the arena
+			if (hashes[id] == hash && offsets[id + 1] - offsets[id] == length
+				&& memcmp(arena.data() + offsets[id], label, length) == 0) {
+				return slot;
+			}
+		}
+	}
+
+	// Doubles the hash table and reinserts every ID using its stored hash
+	void grow()
+	{
+		vector<int> old_slots(slots.size() * 2, NO_VERTEX);
+		old_slots.swap(slots);
+
+		size_t mask = slots.size() - 1;
+		for (int id = 0; id < size(); id++) {
+			size_t slot = hashes[id] & mask;
+			while (slots[slot] != NO_VERTEX) {
+				slot = (slot + 1) & mask;
+			}
+			slots[slot] = id;
+		}
+	}
+};
+
+// @ names: labels of the vertices
+// @ ids: IDs of vertices to be printed, in file order
+// When every label is an integer, sorts the IDs by the value of their labels, the order the original
+// map<int, Vertex> adjacency list printed them in; otherwise leaves them in file order
+inline void sort_by_integer_label(const NameTable& names, vector<int>& ids)
+{
+	vector<pair<long long, int>> keyed(ids.size());
+	for (size_t i = 0; i < ids.size(); i++) {
+		const string label = names.name(ids[i]);
+		char* end;
+		keyed[i] = make_pair(strtoll(label.c_str(), &end, 10), ids[i]);
+		if (label.empty() || *end != '\0') {
+			return;
+		}
+	}
+	stable_sort(keyed.begin(), keyed.end(), [](const pair<long long, int>& a, const pair<long long, int>& b) {
+		return a.first < b.first;
+	});
+	for (size_t i = 0; i < ids.size(); i++) {
+		ids[i] = keyed[i].second;
+	}
+}
+
+#endif
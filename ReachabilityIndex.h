@@ -0,0 +1,385 @@
+/*
+	Author: Vishnu Rampersaud
+	ReachabilityIndex.h header file
+	Answers "is there a path from u to v?" in a graph without cycles from interval labels and the topological
+	numbers of topSort(), searching the graph only when they cannot tell
+*/
+#ifndef REACHABILITY_INDEX_H
+#define REACHABILITY_INDEX_H
+
+#include "Vertex.h"
+#include "NameTable.h"
+#include "EdgeArrays.h"
+#include "SearchWorkspace.h"
+#include "ThreadPool.h"
+#include "Stats.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cstdint>
+#include <algorithm>
+using namespace std;
+
+// Interval of one vertex in one labeling; the interval of every vertex a vertex can reach lies inside its own
+struct ReachInterval {
+	uint32_t low;
+	uint32_t post;
+};
+
+// How the queries of one thread were answered
+struct ReachQueryStats {
+	unsigned long long queries;
+	unsigned long long by_order;
+	unsigned long long by_labels;
+	unsigned long long by_search;
+	unsigned long long vertices_visited;
+};
+
+// Search state of one thread, reused for every query it answers
+struct ReachBuffer {
+	BitMask visited;
+	vector<int> stack;
+	ReachQueryStats stats;
+
+	explicit ReachBuffer(size_t vertices = 0) : visited(vertices), stats()
+	{
+	}
+};
+
+// ReachabilityIndex class
+// Interval labels as in GRAIL (Yildirim, Chaoji and Zaki). Each labeling is a depth first traversal of the graph
+// from its sources, visiting the edges of a vertex in a random order; post(v) is the rank of v in the order the
+// traversal finishes the vertices, and low(v) is the smallest post() of the vertices v reaches. If u reaches v, the
+// interval [low(v), post(v)] lies inside [low(u), post(u)] in every labeling, so a labeling where it does not
+// shows there is no path. Different random orders rule out different pairs, so a few labelings are kept.
+//
+// A query from u to v is answered by:
+//  - the topological numbers: u can only reach v if u comes before v in the topological order
+//  - the labels: v's intervals must all lie inside u's
+//  - otherwise a depth first search from u, which skips every vertex that fails either test for v
+// Most pairs in a large graph have no path, and the first two tests answer them in O(labels).
+//
+// The labelings are independent of each other and are built in parallel, and the index can be saved to a file
+// and loaded instead of being built again.
+template <typename Weight>
+class ReachabilityIndex {
+public:
+
+	// Number of labelings when none is given
+	static const int DEFAULT_LABELS = 5;
+
+	// @ adjacency_list: a graph without cycles, on which topSort() has been run
+	explicit ReachabilityIndex(const vector<Vertex<int, Weight>>& adjacency_list)
+		: out_edges(adjacency_list, false), top_num(adjacency_list.size()), label_count_(0)
+	{
+		for (size_t v = 0; v < adjacency_list.size(); v++) {
+			top_num[v] = adjacency_list[v].get_topNum();
+		}
+	}
+
+	// @ label_count: number of labelings
+	// @ pool: threads to build the labelings on, one labeling per thread at a time
+	// @ seed: seed of the random edge orders
+	void build(int label_count, ThreadPool& pool, unsigned seed = 1)
+	{
+		STATS_PHASE(build_timer, "reach_index_build");
+		const int n = vertex_count();
+		label_count_ = label_count;
+		labels.assign(static_cast<size_t>(n) * label_count, ReachInterval());
+
+		// The traversals start from the sources, the vertices with no edges in
+		vector<char> has_edge_in(n, 0);
+		for (size_t e = 0; e < out_edges.head.size(); e++) {
+			has_edge_in[out_edges.head[e]] = 1;
+		}
+		vector<int> sources;
+		for (int v = 0; v < n; v++) {
+			if (!has_edge_in[v]) {
+				sources.push_back(v);
+			}
+		}
+
+		pool.parallel_for(label_count, [&](size_t labeling, int) {
+			label(labeling, sources, seed + labeling);
+		});
+	}
+
+	int vertex_count() const
+	{
+		return top_num.size();
+	}
+
+	int label_count() const
+	{
+		return label_count_;
+	}
+
+	// @ from: vertex the path starts at
+	// @ to: vertex the path ends at
+	// @ buffer: search state of the calling thread; its stats count how the query was answered
+	// Returns whether there is a path from the vertex from to the vertex to
+	bool reaches(int from, int to, ReachBuffer& buffer) const
+	{
+		ReachQueryStats& stats = buffer.stats;
+		stats.queries++;
+		if (from == to) {
+			stats.by_order++;
+			return true;
+		}
+		if (top_num[from] >= top_num[to]) {
+			stats.by_order++;
+			return false;
+		}
+		if (!contains(from, to)) {
+			stats.by_labels++;
+			return false;
+		}
+
+		// Search from the vertex from, only through vertices that pass both tests
+		stats.by_search++;
+		buffer.visited.clear();
+		buffer.stack.clear();
+		buffer.visited.set(from);
+		buffer.stack.push_back(from);
+		bool found = false;
+		while (!buffer.stack.empty() && !found) {
+			const int u = buffer.stack.back();
+			buffer.stack.pop_back();
+			stats.vertices_visited++;
+			for (size_t e = out_edges.first[u]; e < out_edges.first[u + 1]; e++) {
+				const int w = out_edges.head[e];
+				if (w == to) {
+					found = true;
+					break;
+				}
+				if (!buffer.visited.test(w) && top_num[w] < top_num[to] && contains(w, to)) {
+					buffer.visited.set(w);
+					buffer.stack.push_back(w);
+				}
+			}
+		}
+		return found;
+	}
+
+	// Writes the index to a file: "GRI1", the number of vertices (4 bytes), of edges (8 bytes), a fingerprint of the
+	// edges (8 bytes) and the number of labelings (4 bytes), then the labels of each vertex in turn, low before post
+	// Returns false if the file could not be written
+	bool save(const string& filename) const
+	{
+		ofstream out(filename, ios::binary);
+		const uint32_t n = vertex_count();
+		const uint64_t edges = out_edges.head.size();
+		const uint64_t edge_fingerprint = fingerprint();
+		const uint32_t count = label_count_;
+		out.write("GRI1", 4);
+		out.write(reinterpret_cast<const char*>(&n), sizeof(n));
+		out.write(reinterpret_cast<const char*>(&edges), sizeof(edges));
+		out.write(reinterpret_cast<const char*>(&edge_fingerprint), sizeof(edge_fingerprint));
+		out.write(reinterpret_cast<const char*>(&count), sizeof(count));
+		out.write(reinterpret_cast<const char*>(labels.data()), labels.size() * sizeof(ReachInterval));
+		return static_cast<bool>(out);
+	}
+
+	// Reads an index written by save() for the same graph, numbered the same way
+	// Returns false, and leaves the index as it was, if the file is not an index of a graph with the same edges
+	// between the same vertex IDs; the labels depend on the IDs, which change with --order and the order of the lines
+	bool load(const string& filename)
+	{
+		STATS_PHASE(load_timer, "reach_index_load");
+		ifstream in(filename, ios::binary);
+		char magic[4];
+		uint32_t n = 0, count = 0;
+		uint64_t edges = 0, edge_fingerprint = 0;
+		in.read(magic, sizeof(magic));
+		in.read(reinterpret_cast<char*>(&n), sizeof(n));
+		in.read(reinterpret_cast<char*>(&edges), sizeof(edges));
+		in.read(reinterpret_cast<char*>(&edge_fingerprint), sizeof(edge_fingerprint));
+		in.read(reinterpret_cast<char*>(&count), sizeof(count));
+		if (!in || string(magic, 4) != "GRI1" || n != top_num.size() || edges != out_edges.head.size()
+			|| edge_fingerprint != fingerprint() || count == 0) {
+			return false;
+		}
+		vector<ReachInterval> file_labels(static_cast<size_t>(n) * count);
+		in.read(reinterpret_cast<char*>(file_labels.data()), file_labels.size() * sizeof(ReachInterval));
+		if (!in) {
+			return false;
+		}
+		labels.swap(file_labels);
+		label_count_ = count;
+		return true;
+	}
+
+private:
+	EdgeArrays<Weight> out_edges;
+	vector<int> top_num;
+	int label_count_;
+
+	// labels[v * label_count_ + i] is the interval of vertex v in labeling i
+	vector<ReachInterval> labels;
+
+	// Returns a hash (64 bit FNV-1a, a whole value at a time) of the edges out of each vertex in ID order, which changes if the vertices
+	// are numbered differently
+	uint64_t fingerprint() const
+	{
+		uint64_t hash = 14695981039346656037ULL;
+		for (int v = 0; v < vertex_count(); v++) {
+			const uint64_t values[2] = { out_edges.first[v + 1], static_cast<uint64_t>(v) };
+			for (int i = 0; i < 2; i++) {
+				hash = (hash ^ values[i]) * 1099511628211ULL;
+			}
+			for (size_t e = out_edges.first[v]; e < out_edges.first[v + 1]; e++) {
+				hash = (hash ^ static_cast<uint32_t>(out_edges.head[e])) * 1099511628211ULL;
+			}
+		}
+		return hash;
+	}
+
+	// Returns whether the intervals of v lie inside those of u in every labeling
+	bool contains(int u, int v) const
+	{
+		const ReachInterval* outer = &labels[static_cast<size_t>(u) * label_count_];
+		const ReachInterval* inner = &labels[static_cast<size_t>(v) * label_count_];
+		for (int i = 0; i < label_count_; i++) {
+			if (inner[i].low < outer[i].low || inner[i].post > outer[i].post) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// One depth first traversal; each vertex starts at a random one of its edges and goes round them all
+	void label(size_t labeling, vector<int> sources, unsigned seed)
+	{
+		const int n = vertex_count();
+		mt19937 random(seed);
+		shuffle(sources.begin(), sources.end(), random);
+
+		// Each entry of the stack is a vertex, the edge it started at, and how many of its edges have been followed
+		struct Frame {
+			int vertex;
+			size_t start;
+			size_t followed;
+		};
+		vector<Frame> stack;
+		vector<char> visited(n, 0);
+		uint32_t rank = 0;
+		for (size_t s = 0; s < sources.size(); s++) {
+			Frame root = { sources[s], 0, 0 };
+			stack.push_back(root);
+			visited[sources[s]] = 1;
+			at(sources[s], labeling).low = UINT32_MAX;
+			while (!stack.empty()) {
+				Frame& frame = stack.back();
+				const int u = frame.vertex;
+				const size_t degree = out_edges.first[u + 1] - out_edges.first[u];
+				if (frame.followed == 0 && degree > 0) {
+					frame.start = random() % degree;
+				}
+				if (frame.followed < degree) {
+					const int w = out_edges.head[out_edges.first[u] + (frame.start + frame.followed) % degree];
+					frame.followed++;
+					if (!visited[w]) {
+						visited[w] = 1;
+						at(w, labeling).low = UINT32_MAX;
+						Frame next = { w, 0, 0 };
+						stack.push_back(next);
+					}
+					else {
+						// Without cycles, a vertex seen before has already been finished
+						at(u, labeling).low = min(at(u, labeling).low, at(w, labeling).low);
+					}
+					continue;
+				}
+				ReachInterval& interval = at(u, labeling);
+				interval.post = ++rank;
+				interval.low = min(interval.low, interval.post);
+				stack.pop_back();
+				if (!stack.empty()) {
+					ReachInterval& parent = at(stack.back().vertex, labeling);
+					parent.low = min(parent.low, interval.low);
+				}
+			}
+		}
+	}
+
+	ReachInterval& at(int v, size_t labeling)
+	{
+		return labels[static_cast<size_t>(v) * label_count_ + labeling];
+	}
+};
+
+// @ query_filename: file with one query per line, "<vertex> <vertex>"
+// @ index: reachability index of the graph
+// @ names: labels of the vertices in the graph
+// @ pool: threads to answer the queries on, each with its own search buffer
+// Prints whether there is a path from the first vertex of each query to the second, then how the queries were answered
+template <typename Weight>
+void runReachQueries(const string& query_filename, const ReachabilityIndex<Weight>& index, const NameTable& names, ThreadPool& pool)
+{
+	STATS_PHASE(query_timer, "reach_queries");
+	ifstream query_file(query_filename);
+	vector<pair<string, string>> queries;
+	string line;
+	while (getline(query_file, line)) {
+		istringstream query(line);
+		string vertex_1, vertex_2;
+		if (query >> vertex_1 >> vertex_2) {
+			queries.push_back(make_pair(vertex_1, vertex_2));
+		}
+	}
+
+	// 0 and 1 are the answers; the other values mark a vertex that is not in the graph
+	const char first_not_found = 2, second_not_found = 3;
+	vector<char> answers(queries.size());
+	vector<ReachBuffer> buffers(pool.size(), ReachBuffer(index.vertex_count()));
+	const size_t chunk = 1024;
+	auto start = chrono::steady_clock::now();
+	pool.parallel_for((queries.size() + chunk - 1) / chunk, [&](size_t task, int thread) {
+		const size_t end = min(queries.size(), (task + 1) * chunk);
+		for (size_t q = task * chunk; q < end; q++) {
+			const int from = names.find(queries[q].first);
+			const int to = names.find(queries[q].second);
+			if (from == NO_VERTEX) {
+				answers[q] = first_not_found;
+			}
+			else if (to == NO_VERTEX) {
+				answers[q] = second_not_found;
+			}
+			else {
+				answers[q] = index.reaches(from, to, buffers[thread]);
+			}
+		}
+	});
+	const double milliseconds = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+	ReachQueryStats total = ReachQueryStats();
+	for (size_t t = 0; t < buffers.size(); t++) {
+		total.queries += buffers[t].stats.queries;
+		total.by_order += buffers[t].stats.by_order;
+		total.by_labels += buffers[t].stats.by_labels;
+		total.by_search += buffers[t].stats.by_search;
+		total.vertices_visited += buffers[t].stats.vertices_visited;
+	}
+
+	for (size_t q = 0; q < queries.size(); q++) {
+		cout << queries[q].first << " " << queries[q].second << ": ";
+		if (answers[q] == first_not_found) {
+			cout << "Vertex " << queries[q].first << " not found" << endl;
+		}
+		else if (answers[q] == second_not_found) {
+			cout << "Vertex " << queries[q].second << " not found" << endl;
+		}
+		else {
+			cout << (answers[q] ? "Reachable" : "Not reachable") << endl;
+		}
+	}
+	cout << "\n" << total.queries << " queries in " << milliseconds << " ms: " << total.by_order << " answered by topological order, "
+		<< total.by_labels << " by interval labels, " << total.by_search << " by search (" << total.vertices_visited
+		<< " vertices visited)" << endl;
+}
+
+#endif
@@ -0,0 +1,146 @@
+/*
+	Author: Vishnu Rampersaud
+	SearchWorkspace.h header file
+	The state of one shortest path search, kept apart from the graph so that several threads can
+	search the same graph at once, and reset in time proportional to what the last search touched
+*/
+#ifndef SEARCH_WORKSPACE_H
+#define SEARCH_WORKSPACE_H
+
+#include "WeightTraits.h"
+#include "NameTable.h"
+#include "FindPaths.h"
+#include "binary_heap.h"
+#include <vector>
+#include <cstdint>
+using namespace std;
+
+// BitMask class
+// A bitset with one bit per vertex (or per edge) that can be cleared in time proportional to the number of bits set
+class BitMask {
+public:
+
+	// @ size: number of bits
+	explicit BitMask(size_t size = 0) : words((size + 63) / 64, 0)
+	{
+	}
+
+	bool test(size_t bit) const
+	{
+		return (words[bit / 64] >> (bit % 64)) & 1;
+	}
+
+	void set(size_t bit)
+	{
+		uint64_t& word = words[bit / 64];
+		if (word == 0) {
+			used_words.push_back(bit / 64);
+		}
+		word |= uint64_t(1) << (bit % 64);
+	}
+
+	// Clears every bit
+	void clear()
+	{
+		for (size_t i = 0; i < used_words.size(); i++) {
+			words[used_words[i]] = 0;
+		}
+		used_words.clear();
+	}
+
+private:
+	vector<uint64_t> words;
+
+	// Words that have had a bit set since the last clear()
+	vector<size_t> used_words;
+};
+
+// SearchWorkspace class
+// Distances, paths and the priority queue of a Dijkstra style search over vertex IDs
+// Only the vertices a search reaches are touched, and reset() puts only those back, so a workspace
+// can be reused for many small searches on a large graph without clearing arrays of the graph's size
+template <typename Weight>
+class SearchWorkspace {
+public:
+
+	// @ number_of_vertices: number of vertices in the graph to search
+	explicit SearchWorkspace(int number_of_vertices = 0)
+		: distance_(number_of_vertices, WeightTraits<Weight>::infinity()), path_(number_of_vertices, NO_VERTEX)
+	{
+	}
+
+	// Forgets the last search; every vertex is unreached again
+	void reset()
+	{
+		for (size_t i = 0; i < touched_.size(); i++) {
+			distance_[touched_[i]] = WeightTraits<Weight>::infinity();
+			path_[touched_[i]] = NO_VERTEX;
+		}
+		touched_.clear();
+		queue_.makeEmpty();
+	}
+
+	// @ v: ID of a vertex
+	// @ distance: cost of a path to v
+	// @ previous: the vertex before v on that path, or NO_VERTEX
+	// Records the path and queues v if it is cheaper than the best one known
+	// Returns true if it was cheaper
+	bool improve(int v, Weight distance, int previous)
+	{
+		if (!(distance < distance_[v])) {
+			return false;
+		}
+		if (distance_[v] == WeightTraits<Weight>::infinity()) {
+			touched_.push_back(v);
+		}
+		distance_[v] = distance;
+		path_[v] = previous;
+		QueueEntry<Weight> entry = { distance, v };
+		queue_.insert(entry);
+		return true;
+	}
+
+	// @ entry: receives the closest queued vertex and its distance
+	// Removes the closest queued vertex whose distance is still current; stale entries are skipped
+	// Returns false when the queue is empty
+	bool next(QueueEntry<Weight>& entry)
+	{
+		while (!queue_.isEmpty()) {
+			queue_.deleteMin(entry);
+			if (entry.distance == distance_[entry.id]) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	// Returns the smallest distance in the queue, or infinity if it is empty; may be a stale entry's
+	Weight peek_distance() const
+	{
+		return queue_.isEmpty() ? WeightTraits<Weight>::infinity() : queue_.findMin().distance;
+	}
+
+	Weight distance(int v) const
+	{
+		return distance_[v];
+	}
+
+	int path(int v) const
+	{
+		return path_[v];
+	}
+
+	// Returns the vertices reached by the search, in the order they were first reached
+	const vector<int>& touched() const
+	{
+		return touched_;
+	}
+
+private:
+	vector<Weight> distance_;
+	vector<int> path_;
+	vector<int> touched_;
+	BinaryHeap<QueueEntry<Weight>> queue_;
+};
+
+#endif
@@ -0,0 +1,155 @@
+/*
+	Author: Vishnu Rampersaud
+	Finds a minimum spanning forest of a graph and prints its edges and total weight, or compares the
+	running times of the algorithms
+*/
+
+#include "AdjacencyList.h"
+#include "SpanningTree.h"
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <chrono>
+#include <cstdlib>
+#include <cmath>
+#include <algorithm>
+using namespace std;
+
+bool testFiles(const vector<string>& files)
+{
+	ifstream file;
+	for (size_t i = 0; i < files.size(); i++) {
+		file.open(files[i]);
+		if (file.is_open()) {
+			file.close();
+			continue;
+		}
+		else {
+			cout << files[i] << " does not exist in the current directory." << endl;
+			cout << "Program will terminate" << endl;
+			return false;
+		}
+	}
+
+	return true;
+}
+
+// @ adjacency_list: the graph
+// @ pool: threads for the parallel algorithms
+// @ repeats: number of times to run each algorithm
+// Runs every algorithm and prints the fastest of its running times, and whether they all found the same total weight
+template <typename Weight>
+void compareMethods(const vector<Vertex<int, Weight>>& adjacency_list, ThreadPool& pool, int repeats)
+{
+	const SpanningTreeMethod methods[] = { SpanningTreeMethod::PRIM, SpanningTreeMethod::BORUVKA, SpanningTreeMethod::KRUSKAL };
+	double first_weight = 0;
+	bool agree = true;
+	cout << left << setw(10) << "method" << setw(14) << "min ms" << setw(14) << "mean ms" << "total weight" << endl;
+	for (int m = 0; m < 3; m++) {
+		double fastest = 0, sum = 0, weight = 0;
+		for (int r = 0; r < repeats; r++) {
+			auto start = chrono::steady_clock::now();
+			SpanningForest<Weight> forest = spanning_forest(adjacency_list, methods[m], pool);
+			double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+			fastest = r == 0 ? ms : min(fastest, ms);
+			sum += ms;
+			weight = forest.total_weight;
+		}
+		if (m == 0) {
+			first_weight = weight;
+		}
+		// The weights are added in a different order by each method, so doubles may differ in the last digits
+		agree = agree && fabs(weight - first_weight) <= 1e-9 * max(1.0, fabs(first_weight));
+		cout << left << setw(10) << spanning_tree_method_name(methods[m]) << setw(14) << fastest << setw(14) << sum / repeats
+			<< setprecision(15) << weight << setprecision(6) << endl;
+	}
+	cout << (agree ? "All methods found the same total weight" : "The methods found different total weights") << endl;
+}
+
+int main(int argc, char** argv)
+{
+	// Checks to see if the correct number of arguments are entered
+	const string usage = string("Usage: ") + argv[0] + " <GRAPH_FILE> [--method=prim|boruvka|kruskal|compare]"
+		+ " [--threads=<THREADS>] [--repeats=<RUNS>] [--stats[=<STATS_FILE>]]";
+	if (argc < 2) {
+		cout << usage << endl;
+		return 0;
+	}
+
+	// Read the options that follow the required arguments
+	SpanningTreeMethod method = SpanningTreeMethod::PRIM;
+	bool compare = false;
+	int threads = 0;
+	int repeats = 3;
+	string stats_destination;
+	for (int i = 2; i < argc; i++) {
+		const string option(argv[i]);
+		if (option == "--method=compare") {
+			compare = true;
+			continue;
+		}
+		if (option.compare(0, 9, "--method=") == 0 && parse_spanning_tree_method(option.substr(9), method)) {
+			continue;
+		}
+		if (option.compare(0, 10, "--threads=") == 0 && atoi(option.c_str() + 10) >= 0) {
+			threads = atoi(option.c_str() + 10);
+			continue;
+		}
+		if (option.compare(0, 10, "--repeats=") == 0 && atoi(option.c_str() + 10) > 0) {
+			repeats = atoi(option.c_str() + 10);
+			continue;
+		}
+		if (option == "--stats") {
+			stats_destination = "-";
+			continue;
+		}
+		if (option.compare(0, 8, "--stats=") == 0 && option.size() > 8) {
+			stats_destination = option.substr(8);
+			continue;
+		}
+		cout << "Unknown option: " << option << endl;
+		cout << usage << endl;
+		return 0;
+	}
+
+	// Store arguments into a variable
+	const string graph_filename(argv[1]);
+
+	// Test to see if files are valid; If they exist in the current directory
+	vector<string> files;
+	files.push_back(graph_filename);
+	if (!testFiles(files)) {
+		return 0;
+	}
+
+	// Display files that will be used
+	cout << "\nInput Graph file: " << graph_filename << "\n" << endl;
+
+	// Create empty vector to store adjacency list, and a table for the vertex labels
+	vector<Vertex<int, weight_type>> adjacency_list;
+	NameTable names;
+
+	// Create adjacency list to represent the input graph
+	if (!createAdjacencyList(graph_filename, adjacency_list, names)) {
+		cout << "Program will terminate" << endl;
+		return 0;
+	}
+
+	ThreadPool pool(threads);
+	if (compare) {
+		compareMethods(adjacency_list, pool, repeats);
+	}
+	else {
+		SpanningForest<weight_type> forest = spanning_forest(adjacency_list, method, pool);
+		printForest(forest, names);
+		cout << "\nMinimum spanning " << (forest.trees == 1 ? "tree" : "forest") << " (" << spanning_tree_method_name(method) << "): "
+			<< forest.edges.size() << " edges, " << forest.trees << (forest.trees == 1 ? " tree" : " trees")
+			<< ", total weight " << setprecision(15) << forest.total_weight << endl;
+	}
+
+	// Print the phase times and counters if they were asked for
+	report_stats(stats_destination, "SpanningTree");
+	return 0;
+}
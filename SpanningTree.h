@@ -0,0 +1,385 @@
+/*
+	Author: Vishnu Rampersaud
+	SpanningTree.h header file
+	Minimum spanning forests of a graph, by Prim's algorithm on the binary heap, by Boruvka's algorithm in
+	parallel, or by filter-Kruskal
+*/
+#ifndef SPANNING_TREE_H
+#define SPANNING_TREE_H
+
+#include "Vertex.h"
+#include "NameTable.h"
+#include "WeightTraits.h"
+#include "FindPaths.h"
+#include "EdgeArrays.h"
+#include "ThreadPool.h"
+#include "binary_heap.h"
+#include "Stats.h"
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <algorithm>
+using namespace std;
+
+// The edges of the graph are taken as undirected: an edge from u to v can join u and v either way, and
+// an edge listed in both directions is two candidate edges, of which the lighter may be used.
+
+enum class SpanningTreeMethod { PRIM, BORUVKA, KRUSKAL };
+
+// @ name: name of a method, as given on the command line
+// @ method: set to the method with this name
+// Returns false if there is no method with this name
+inline bool parse_spanning_tree_method(const string& name, SpanningTreeMethod& method)
+{
+	if (name == "prim") { method = SpanningTreeMethod::PRIM; }
+	else if (name == "boruvka") { method = SpanningTreeMethod::BORUVKA; }
+	else if (name == "kruskal") { method = SpanningTreeMethod::KRUSKAL; }
+	else { return false; }
+	return true;
+}
+
+// Returns the name of a method
+inline const char* spanning_tree_method_name(SpanningTreeMethod method)
+{
+	switch (method) {
+	case SpanningTreeMethod::PRIM: return "prim";
+	case SpanningTreeMethod::BORUVKA: return "boruvka";
+	default: return "kruskal";
+	}
+}
+
+// An edge of the graph, numbered so that edges of equal weight still have a strict order
+template <typename Weight>
+struct SpanningEdge {
+	int from;
+	int to;
+	Weight weight;
+	int id;
+
+	// Every method picks the lightest edge by this order, so with equal weights they still agree on a
+	// total order and never close a cycle
+	bool operator<(const SpanningEdge& rhs) const
+	{
+		if (weight != rhs.weight) {
+			return weight < rhs.weight;
+		}
+		return id < rhs.id;
+	}
+};
+
+// A minimum spanning forest: one tree per connected part of the graph
+template <typename Weight>
+struct SpanningForest {
+	vector<SpanningEdge<Weight>> edges;
+
+	// Summed as a double, so it cannot overflow a small integer weight type
+	double total_weight;
+	int trees;
+};
+
+// DisjointSets class
+// Union-find with union by rank and path halving
+class DisjointSets {
+public:
+
+	// @ size: number of elements, each in its own set at first
+	explicit DisjointSets(int size) : parent(size), rank(size, 0)
+	{
+		for (int i = 0; i < size; i++) {
+			parent[i] = i;
+		}
+	}
+
+	// Returns the representative of the set of x, shortening the path to it
+	int find(int x)
+	{
+		while (parent[x] != x) {
+			parent[x] = parent[parent[x]];
+			x = parent[x];
+		}
+		return x;
+	}
+
+	// Returns the representative of the set of x without changing anything, so several threads may call it at once
+	int find_root(int x) const
+	{
+		while (parent[x] != x) {
+			x = parent[x];
+		}
+		return x;
+	}
+
+	// Joins the sets of x and y; returns false if they were already the same set
+	bool unite(int x, int y)
+	{
+		x = find(x);
+		y = find(y);
+		if (x == y) {
+			return false;
+		}
+		if (rank[x] < rank[y]) {
+			swap(x, y);
+		}
+		parent[y] = x;
+		if (rank[x] == rank[y]) {
+			rank[x]++;
+		}
+		return true;
+	}
+
+private:
+	vector<int> parent;
+	vector<int> rank;
+};
+
+// @ adjacency_list: the graph
+// Returns every edge of the graph except loops, numbered in the order of the adjacency lists
+template <typename Weight>
+vector<SpanningEdge<Weight>> spanning_edges(const vector<Vertex<int, Weight>>& adjacency_list)
+{
+	vector<SpanningEdge<Weight>> edges;
+	for (size_t v = 0; v < adjacency_list.size(); v++) {
+		for (auto edge : adjacency_list[v].adjacent()) {
+			if (edge.first != static_cast<int>(v)) {
+				SpanningEdge<Weight> e = { static_cast<int>(v), edge.first, edge.second, static_cast<int>(edges.size()) };
+				edges.push_back(e);
+			}
+		}
+	}
+	return edges;
+}
+
+// @ forest: a forest whose edges are all found
+// @ vertices: number of vertices in the graph
+// Fills in the total weight and the number of trees
+template <typename Weight>
+void finish_forest(SpanningForest<Weight>& forest, int vertices)
+{
+	forest.total_weight = 0;
+	for (size_t e = 0; e < forest.edges.size(); e++) {
+		forest.total_weight += static_cast<double>(forest.edges[e].weight);
+	}
+	forest.trees = vertices - forest.edges.size();
+}
+
+// @ adjacency_list: the graph
+// Prim's algorithm, started again from the next vertex not yet in a tree until every vertex is in one
+// The heap holds one entry per vertex next to the trees, keyed by its lightest edge to them; a lighter edge
+// lowers the key with decreaseKey(), which the heap's position index makes O(log V)
+template <typename Weight>
+SpanningForest<Weight> prim(const vector<Vertex<int, Weight>>& adjacency_list)
+{
+	STATS_PHASE(prim_timer, "prim");
+	const int n = adjacency_list.size();
+	EdgeArrays<Weight> out_edges(adjacency_list, false), in_edges(adjacency_list, true);
+	vector<Weight> key(n, WeightTraits<Weight>::infinity());
+	vector<int> link(n, NO_VERTEX);
+	vector<char> in_tree(n, 0);
+	BinaryHeap<QueueEntry<Weight>, HeapIndex<QueueEntryId>> priority_queue;
+
+	SpanningForest<Weight> forest;
+	for (int root = 0; root < n; root++) {
+		if (in_tree[root]) {
+			continue;
+		}
+		key[root] = 0;
+		QueueEntry<Weight> entry = { key[root], root };
+		priority_queue.insert(entry);
+
+		while (!priority_queue.isEmpty()) {
+			QueueEntry<Weight> top;
+			priority_queue.deleteMin(top);
+			const int u = top.id;
+			in_tree[u] = 1;
+			STATS_COUNT(vertices_settled);
+			if (link[u] != NO_VERTEX) {
+				SpanningEdge<Weight> e = { link[u], u, key[u], 0 };
+				forest.edges.push_back(e);
+			}
+
+			// The edges out of u and into u can both join a vertex to the tree
+			const EdgeArrays<Weight>* sides[2] = { &out_edges, &in_edges };
+			for (int side = 0; side < 2; side++) {
+				const EdgeArrays<Weight>& edges = *sides[side];
+				for (size_t e = edges.first[u]; e < edges.first[u + 1]; e++) {
+					const int v = edges.head[e];
+					if (in_tree[v] || !(edges.weight[e] < key[v])) {
+						continue;
+					}
+					STATS_COUNT(edges_relaxed);
+					const bool queued = key[v] != WeightTraits<Weight>::infinity();
+					key[v] = edges.weight[e];
+					link[v] = u;
+					QueueEntry<Weight> lighter = { key[v], v };
+					if (queued) {
+						priority_queue.decreaseKey(lighter);
+					}
+					else {
+						priority_queue.insert(lighter);
+					}
+				}
+			}
+		}
+	}
+	finish_forest(forest, n);
+	return forest;
+}
+
+// @ adjacency_list: the graph
+// @ pool: threads to find the lightest edges on
+// Boruvka's algorithm: every round, each tree picks the lightest edge leaving it, and all those edges are added
+// at once, so the number of trees at least halves each round. The lightest edges are found in parallel over the
+// edges, each thread offering an edge to both of its trees with an atomic compare and swap. After each round the
+// edges inside a tree are dropped.
+template <typename Weight>
+SpanningForest<Weight> boruvka(const vector<Vertex<int, Weight>>& adjacency_list, ThreadPool& pool)
+{
+	STATS_PHASE(boruvka_timer, "boruvka");
+	const int n = adjacency_list.size();
+	vector<SpanningEdge<Weight>> edges = spanning_edges(adjacency_list);
+	DisjointSets trees(n);
+	vector<int> tree_of(n);
+	for (int v = 0; v < n; v++) {
+		tree_of[v] = v;
+	}
+	vector<atomic<int>> lightest(n);
+	const size_t chunk = 4096;
+
+	SpanningForest<Weight> forest;
+	while (!edges.empty()) {
+		for (int v = 0; v < n; v++) {
+			lightest[v].store(-1, memory_order_relaxed);
+		}
+
+		// Offer edge e to tree t: keep whichever is lighter
+		auto offer = [&](int t, int e) {
+			int current = lightest[t].load(memory_order_relaxed);
+			while (current == -1 || edges[e] < edges[current]) {
+				if (lightest[t].compare_exchange_weak(current, e, memory_order_relaxed)) {
+					break;
+				}
+			}
+		};
+		pool.parallel_for((edges.size() + chunk - 1) / chunk, [&](size_t task, int) {
+			const size_t end = min(edges.size(), (task + 1) * chunk);
+			for (size_t e = task * chunk; e < end; e++) {
+				offer(tree_of[edges[e].from], e);
+				offer(tree_of[edges[e].to], e);
+			}
+		});
+
+		for (int t = 0; t < n; t++) {
+			const int e = lightest[t].load(memory_order_relaxed);
+			if (e != -1 && trees.unite(edges[e].from, edges[e].to)) {
+				forest.edges.push_back(edges[e]);
+			}
+		}
+
+		// Drop the edges that no longer join two trees
+		for (int v = 0; v < n; v++) {
+			tree_of[v] = trees.find(v);
+		}
+		size_t kept = 0;
+		for (size_t e = 0; e < edges.size(); e++) {
+			if (tree_of[edges[e].from] != tree_of[edges[e].to]) {
+				edges[kept++] = edges[e];
+			}
+		}
+		edges.resize(kept);
+	}
+	finish_forest(forest, n);
+	return forest;
+}
+
+// Below this many edges, filter-Kruskal sorts the edges instead of splitting them further
+const size_t KRUSKAL_SORT_EDGES = 1024;
+
+// @ edges: edges to add, lightest first; reordered
+// @ trees: the trees found so far; joined by the edges added
+// @ forest: receives the edges added
+// @ pool: threads to filter the edges on
+// Filter-Kruskal: the lighter half of the edges is added first (recursively); then the heavier half is filtered,
+// in parallel, down to the edges that still join two trees before it is added. On most graphs the filter drops
+// most heavy edges, so they are never sorted.
+template <typename Weight>
+void filter_kruskal(vector<SpanningEdge<Weight>>& edges, DisjointSets& trees, SpanningForest<Weight>& forest, ThreadPool& pool)
+{
+	if (edges.size() <= KRUSKAL_SORT_EDGES) {
+		sort(edges.begin(), edges.end());
+		for (size_t e = 0; e < edges.size(); e++) {
+			if (trees.unite(edges[e].from, edges[e].to)) {
+				forest.edges.push_back(edges[e]);
+			}
+		}
+		return;
+	}
+
+	const size_t half = edges.size() / 2;
+	nth_element(edges.begin(), edges.begin() + half, edges.end());
+	vector<SpanningEdge<Weight>> heavy(edges.begin() + half, edges.end());
+	edges.resize(half);
+	filter_kruskal(edges, trees, forest, pool);
+
+	const size_t chunk = 4096;
+	vector<char> keep(heavy.size());
+	pool.parallel_for((heavy.size() + chunk - 1) / chunk, [&](size_t task, int) {
+		const size_t end = min(heavy.size(), (task + 1) * chunk);
+		for (size_t e = task * chunk; e < end; e++) {
+			keep[e] = trees.find_root(heavy[e].from) != trees.find_root(heavy[e].to);
+		}
+	});
+	size_t kept = 0;
+	for (size_t e = 0; e < heavy.size(); e++) {
+		if (keep[e]) {
+			heavy[kept++] = heavy[e];
+		}
+	}
+	heavy.resize(kept);
+	filter_kruskal(heavy, trees, forest, pool);
+}
+
+// @ adjacency_list: the graph
+// @ pool: threads to filter the edges on
+// Kruskal's algorithm, splitting and filtering the edges instead of sorting all of them first
+template <typename Weight>
+SpanningForest<Weight> kruskal(const vector<Vertex<int, Weight>>& adjacency_list, ThreadPool& pool)
+{
+	STATS_PHASE(kruskal_timer, "kruskal");
+	vector<SpanningEdge<Weight>> edges = spanning_edges(adjacency_list);
+	DisjointSets trees(adjacency_list.size());
+	SpanningForest<Weight> forest;
+	filter_kruskal(edges, trees, forest, pool);
+	finish_forest(forest, adjacency_list.size());
+	return forest;
+}
+
+// @ adjacency_list: the graph
+// @ method: the algorithm to use
+// @ pool: threads for Boruvka's algorithm and filter-Kruskal
+// Returns a minimum spanning forest of the graph
+template <typename Weight>
+SpanningForest<Weight> spanning_forest(const vector<Vertex<int, Weight>>& adjacency_list, SpanningTreeMethod method, ThreadPool& pool)
+{
+	switch (method) {
+	case SpanningTreeMethod::PRIM: return prim(adjacency_list);
+	case SpanningTreeMethod::BORUVKA: return boruvka(adjacency_list, pool);
+	default: return kruskal(adjacency_list, pool);
+	}
+}
+
+// @ forest: a minimum spanning forest
+// @ names: labels of the vertices in the graph
+// Prints the edges of the forest with their weights
+template <typename Weight>
+void printForest(const SpanningForest<Weight>& forest, const NameTable& names)
+{
+	STATS_PHASE(output_timer, "output");
+	for (size_t e = 0; e < forest.edges.size(); e++) {
+		const SpanningEdge<Weight>& edge = forest.edges[e];
+		cout << names.name(edge.from) << " - " << names.name(edge.to) << " (Weight: " << edge.weight << ")" << endl;
+	}
+}
+
+#endif
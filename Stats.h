@@ -0,0 +1,167 @@
+/*
+	Author: Vishnu Rampersaud
+	Stats.h header file
+	Phase timers and operation counters for the graph programs, printed as JSON with --stats
+*/
+#ifndef STATS_H
+#define STATS_H
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <utility>
+#include <chrono>
+#include <atomic>
+#ifdef __unix__
+#include <sys/resource.h>
+#endif
+using namespace std;
+
+// The timers and counters are only compiled in when GRAPH_STATS is defined, e.g.
+//     make STATS=1 all
+// Otherwise every STATS_ macro expands to nothing, so the algorithms run exactly as without them.
+// --stats still prints a stats block in that case, with "enabled": false and only the peak memory use.
+//
+// STATS_COUNT(counter)       adds one to a counter of GraphStats, e.g. STATS_COUNT(heap_inserts)
+// STATS_PHASE(timer, name)   starts timing a phase; it ends when the timer goes out of scope
+// STATS_STOP(timer)          ends the phase early
+// Time spent in a phase with the same name more than once is added up.
+// The counters are atomic, so searches running on several threads at once add up correctly.
+
+// GraphStats class
+// Counters and phase times collected during one run of a program
+struct GraphStats {
+	atomic<unsigned long long> heap_inserts{0};
+	atomic<unsigned long long> heap_delete_mins{0};
+	atomic<unsigned long long> heap_decrease_keys{0};
+	atomic<unsigned long long> edges_relaxed{0};
+	atomic<unsigned long long> vertices_settled{0};
+
+	// Milliseconds spent in each phase, in the order the phases first ran
+	vector<pair<string, double>> phases;
+
+	// @ name: name of a phase
+	// @ ms: milliseconds spent in it
+	void add_phase(const string& name, double ms)
+	{
+		for (size_t i = 0; i < phases.size(); i++) {
+			if (phases[i].first == name) {
+				phases[i].second += ms;
+				return;
+			}
+		}
+		phases.push_back(make_pair(name, ms));
+	}
+};
+
+// Returns the stats of this run of the program
+inline GraphStats& graph_stats()
+{
+	static GraphStats stats;
+	return stats;
+}
+
+// PhaseTimer class
+// Measures the time from its construction until stop() or its destruction, and adds it to the named phase
+class PhaseTimer {
+public:
+
+	// @ name: name of the phase
+	explicit PhaseTimer(const char* name) : name(name), start(chrono::steady_clock::now()), running(true)
+	{
+	}
+
+	~PhaseTimer()
+	{
+		stop();
+	}
+
+	// Ends the phase; does nothing if it has already ended
+	void stop()
+	{
+		if (running) {
+			graph_stats().add_phase(name, chrono::duration<double, milli>(chrono::steady_clock::now() - start).count());
+			running = false;
+		}
+	}
+
+private:
+	const char* name;
+	chrono::steady_clock::time_point start;
+	bool running;
+};
+
+#ifdef GRAPH_STATS
+#define STATS_COUNT(counter) (++graph_stats().counter)
+#define STATS_PHASE(timer, name) PhaseTimer timer(name)
+#define STATS_STOP(timer) timer.stop()
+#else
+#define STATS_COUNT(counter) ((void)0)
+#define STATS_PHASE(timer, name) ((void)0)
+#define STATS_STOP(timer) ((void)0)
+#endif
+
+// Returns the largest amount of memory the program has held at once, in kilobytes, or 0 if it is not known
+inline long peak_rss_kilobytes()
+{
+#ifdef __unix__
+	rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#ifdef __APPLE__
+		return usage.ru_maxrss / 1024;
+#else
+		return usage.ru_maxrss;
+#endif
+	}
+#endif
+	return 0;
+}
+
+// @ out: where the stats are written
+// @ program: name of the program, for the stats block
+// Writes the stats of this run as one JSON object on one line
+inline void write_stats_json(ostream& out, const string& program)
+{
+#ifdef GRAPH_STATS
+	const bool enabled = true;
+#else
+	const bool enabled = false;
+#endif
+	const GraphStats& stats = graph_stats();
+	out << "{\"stats\": {\"program\": \"" << program << "\", \"enabled\": " << (enabled ? "true" : "false");
+	if (enabled) {
+		out << ", \"phases_ms\": {";
+		for (size_t i = 0; i < stats.phases.size(); i++) {
+			out << (i == 0 ? "" : ", ") << "\"" << stats.phases[i].first << "\": " << stats.phases[i].second;
+		}
+		out << "}, \"counters\": {\"heap_inserts\": " << stats.heap_inserts.load()
+			<< ", \"heap_delete_mins\": " << stats.heap_delete_mins.load()
+			<< ", \"heap_decrease_keys\": " << stats.heap_decrease_keys.load()
+			<< ", \"edges_relaxed\": " << stats.edges_relaxed.load()
+			<< ", \"vertices_settled\": " << stats.vertices_settled.load() << "}";
+	}
+	out << ", \"peak_rss_kb\": " << peak_rss_kilobytes() << "}}" << endl;
+}
+
+// @ destination: "-" for standard output, a file name, or empty if no stats were requested
+// @ program: name of the program, for the stats block
+// Writes the stats block of this run where the --stats option asked for it
+inline void report_stats(const string& destination, const string& program)
+{
+	if (destination.empty()) {
+		return;
+	}
+	if (destination == "-") {
+		write_stats_json(cout, program);
+		return;
+	}
+	ofstream file(destination);
+	if (!file.is_open()) {
+		cout << "Could not write " << destination << endl;
+		return;
+	}
+	write_stats_json(file, program);
+}
+
+#endif
@@ -0,0 +1,144 @@
+/*
+	Author: Vishnu Rampersaud
+	ThreadPool.h header file
+	A fixed set of worker threads that run the iterations of a loop in parallel
+*/
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <algorithm>
+using namespace std;
+
+// ThreadPool class
+// The threads are started once and wait between loops, so a parallel loop costs no thread creation
+// The thread that calls parallel_for() works on the loop too, as thread 0; the workers are threads 1 and up
+// Every iteration is told which thread runs it, so it can use that thread's own buffers without locking
+//
+// Usage:
+//     ThreadPool pool(4);
+//     vector<Buffer> buffers(pool.size());
+//     pool.parallel_for(tasks, [&](size_t task, int thread) { ... buffers[thread] ... });
+class ThreadPool {
+public:
+
+	// @ threads: total number of threads, counting the caller; 0 uses one per hardware thread
+	explicit ThreadPool(int threads = 0)
+		: generation(0), task_count(0), next_task(0), busy_workers(0), stopping(false)
+	{
+		if (threads <= 0) {
+			threads = max(1u, thread::hardware_concurrency());
+		}
+		for (int t = 1; t < threads; t++) {
+			workers.push_back(thread(&ThreadPool::work, this, t));
+		}
+	}
+
+	// Destructor that stops and joins the workers
+	~ThreadPool()
+	{
+		{
+			lock_guard<mutex> guard(lock);
+			stopping = true;
+		}
+		start_signal.notify_all();
+		for (size_t t = 0; t < workers.size(); t++) {
+			workers[t].join();
+		}
+	}
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	// Returns the number of threads, counting the caller
+	int size() const
+	{
+		return workers.size() + 1;
+	}
+
+	// @ count: number of iterations
+	// @ task: called as task(iteration, thread) for every iteration from 0 to count - 1
+	// Runs the iterations on all threads, each thread taking the next iteration as it finishes one,
+	// and returns when all of them are done. Must not be called from inside a task.
+	void parallel_for(size_t count, const function<void(size_t, int)>& task)
+	{
+		if (count == 0) {
+			return;
+		}
+		if (workers.empty() || count == 1) {
+			for (size_t i = 0; i < count; i++) {
+				task(i, 0);
+			}
+			return;
+		}
+
+		{
+			lock_guard<mutex> guard(lock);
+			current_task = &task;
+			task_count = count;
+			next_task.store(0);
+			busy_workers = workers.size();
+			generation++;
+		}
+		start_signal.notify_all();
+
+		run_tasks(0);
+
+		unique_lock<mutex> guard(lock);
+		done_signal.wait(guard, [this]() { return busy_workers == 0; });
+		current_task = nullptr;
+	}
+
+private:
+	vector<thread> workers;
+
+	// Guards everything below except next_task
+	mutex lock;
+	condition_variable start_signal, done_signal;
+
+	// Counts the loops started, so a worker can tell a new loop from the one it already ran
+	unsigned long long generation;
+	const function<void(size_t, int)>* current_task = nullptr;
+	size_t task_count;
+	atomic<size_t> next_task;
+	size_t busy_workers;
+	bool stopping;
+
+	// Takes iterations of the current loop until there are none left
+	void run_tasks(int thread_index)
+	{
+		for (size_t i = next_task.fetch_add(1); i < task_count; i = next_task.fetch_add(1)) {
+			(*current_task)(i, thread_index);
+		}
+	}
+
+	// Body of a worker thread: waits for a loop, works on it, and reports when done
+	void work(int thread_index)
+	{
+		unsigned long long seen = 0;
+		for (;;) {
+			{
+				unique_lock<mutex> guard(lock);
+				start_signal.wait(guard, [this, seen]() { return stopping || generation != seen; });
+				if (stopping) {
+					return;
+				}
+				seen = generation;
+			}
+
+			run_tasks(thread_index);
+
+			lock_guard<mutex> guard(lock);
+			if (--busy_workers == 0) {
+				done_signal.notify_one();
+			}
+		}
+	}
+};
+
+#endif
@@ -0,0 +1,136 @@
+/*
+	Author: Vishnu Rampersaud
+	TopologicalSort.h header file
+	The Topological sorting algorithm and the function that displays its order
+*/
+#ifndef TOPOLOGICAL_SORT_H
+#define TOPOLOGICAL_SORT_H
+
+#include "Vertex.h"
+#include "NameTable.h"
+#include "Stats.h"
+#include <iostream>
+#include <vector>
+#include <queue>
+#include <utility>
+using namespace std;
+
+// Computes the indegree of each vertex in the graph
+// @ adjacency list: an adjacency list that represents the graph
+template <typename Weight>
+void compute_indegree(vector<Vertex<int, Weight>>& adjacency_list)
+{
+	// Set indegree for all vertices to zero
+	for (auto itr = adjacency_list.begin(); itr != adjacency_list.end(); ++itr) {
+		itr->set_indegree(0); 
+	}
+
+	// For each vertex, compute the indegree of their adjacent vertices
+	// By the end of the nested loops, the correct indegrees of each vertex will be known 
+	for (auto itr = adjacency_list.begin(); itr != adjacency_list.end(); ++itr) {
+
+		// Compute indegree of adjacent vertices of the current vertex
+		for (auto edge : itr->adjacent()) {
+
+			// find the vertex and its information in the graph 
+			Vertex<int, Weight>& adjacent_vertex = adjacency_list[edge.first];
+
+			// Get current indegree
+			int indegree_of_adjacent_vertex = adjacent_vertex.get_indegree(); 
+			// Increment indegree
+			indegree_of_adjacent_vertex++;
+			// Store new indegree 
+			adjacent_vertex.set_indegree(indegree_of_adjacent_vertex);
+		}
+	}
+}
+
+// Displays the topological order of the graph
+// @topological_order: vector that contains the topological sorting of the graph
+// @names: labels of the vertices in the graph
+inline void display_topSort(const vector<int>& topological_order, const NameTable& names)
+{
+	STATS_PHASE(output_timer, "output");
+	cout << "Topological Sort: "; 
+	for (size_t i = 0; i < topological_order.size(); i++) {
+		if (i == 0) {
+			cout << "{" << names.name(topological_order[i]) << ", ";
+		}
+		else if (i == topological_order.size() - 1) {
+			cout << names.name(topological_order[i]) << "}" << endl;
+		}
+		else {
+			cout << names.name(topological_order[i]) << ", ";
+		}
+	}
+}
+
+// Topological sorting function 
+// Sorts the graph using the topological sorting algorithm 
+// @ adjacency_list: An adjacency list the represents a graph
+// @ topological_order: Empty vector that will store the topological order of the graph
+// Returns false if the graph has a cycle, in which case there is no topological order
+template <typename Weight>
+bool topSort(vector<Vertex<int, Weight>>& adjacency_list, vector<int>& topological_order)
+{
+	STATS_PHASE(topsort_timer, "topsort");
+
+	// Initialize a queue that will hold the IDs of all vertices with indegree zero
+	queue <int> indegree_of_zero_queue; 
+
+	// Computes the initial indegree of all vertices 
+	compute_indegree(adjacency_list);
+
+	// @ counter: to asses whether the graph has a cycle
+	// @ num_of_vertices: number of vertices in the graph
+	int counter = 0, num_of_vertices=0; 
+
+	// Push all vertices with indegree zero onto the queue
+	// Also calculate the number of vertices in the graph
+	for (auto itr = adjacency_list.begin(); itr != adjacency_list.end(); ++itr) {
+		num_of_vertices++; 
+		if (itr->get_indegree() == 0) {
+			indegree_of_zero_queue.push(itr->get_vertex_name()); 
+		}
+	}
+
+	// Topologically sort the graph
+	while (!indegree_of_zero_queue.empty()) {
+		
+		// Get and pop the first vertex from queue with indegree of zero 
+		Vertex<int, Weight>& v = adjacency_list[indegree_of_zero_queue.front()]; 
+		indegree_of_zero_queue.pop(); 
+
+		// Set the topological number for the vertex
+		v.set_topNum(++counter); 
+		STATS_COUNT(vertices_settled);
+
+		// Store this vertex in the topological order vector 
+		topological_order.push_back(v.get_vertex_name()); 
+
+		// Obtain all adjacent vertices 
+		// Compute indegree for all adjacent vertices of this vertex
+		for (auto edge : v.adjacent()) {
+
+			// Find the vertex
+			Vertex<int, Weight>& adjacent_vertex = adjacency_list[edge.first];
+			STATS_COUNT(edges_relaxed);
+
+			// Compute new indegree
+			int indegree_of_adjacent_vertex = adjacent_vertex.get_indegree(); 
+			indegree_of_adjacent_vertex--; 
+			adjacent_vertex.set_indegree(indegree_of_adjacent_vertex); 
+
+			// If indegree is zero, push it onto the queue
+			if (indegree_of_adjacent_vertex == 0) {
+				indegree_of_zero_queue.push(adjacent_vertex.get_vertex_name()); 
+			}
+
+		}
+	}
+
+	// Checks if the graph has a cycle 
+	return counter == num_of_vertices; 
+}
+
+#endif
@@ -2,7 +2,10 @@
 	Author: Vishnu Rampersaud
 	Vertex.h header file for the Vertex class
 */
+#ifndef VERTEX_H
+#define VERTEX_H
 
+#include "CompressedAdjacency.h"
 #include <iostream>
 #include <string>
 #include <vector>
@@ -13,20 +16,20 @@ using namespace std;
 // Vertex class 
 // Used to store information about an individual vertex in a graph
 // Stores the adjacent vertices of this vertex, and the weight of the corresponding edges
-template <typename Object> 
+// Object is the type of the vertex names (IDs); Weight is the type of the edge weights and path costs
+template <typename Object, typename Weight = double> 
 class Vertex {
 public: 
 
 	// Constructor
-	Vertex() {  
-		distance = 0; 
+	Vertex() : vertex_name(), path(), distance(0), minPathCost(0), topNum(0), indegree(0) {  
 	}
 
 	// @ name: the name of the vertex
 	// One parameter constructor that sets the name of this vertex
-	Vertex(const Object& name)
+	// The search fields start at zero, so copying a new vertex never reads an uninitialized value
+	Vertex(const Object& name) : vertex_name(name), path(), distance(0), minPathCost(0), topNum(0), indegree(0)
 	{
-		vertex_name = name; 
 	}
 
 	// Copy constructor 
@@ -58,23 +61,123 @@ public:
 	// @ node: name of the adjacent vertex 
 	// @ weight: weight of the edge from vertex to this adjacent vertex
 	// Adds adjacent vertices along with their corresponding weights to this Vertex
-	void add_adjacent_vertex(const Object& node, const double& weight)
+	// A compressed adjacency list is expanded again first
+	void add_adjacent_vertex(const Object& node, const Weight& weight)
 	{
+		if (!compressed_adjacency.empty()) {
+			decompress_adjacency();
+		}
+
 		// Create new data structure that holds the adjacent vertex and its weight
-		pair<Object, double> adjacent_vertex{ node, weight };
+		pair<Object, Weight> adjacent_vertex{ node, weight };
 
 		// Add adjacent vertex to list of adjacent vertices
 		adjacent_vertices.push_back(adjacent_vertex);
 	}
 
-	// Returns list of adjacent vertices; not their weights
-	const vector<pair<Object, double>> get_adjacent_nodes() const
+	// @ node: name of an adjacent vertex
+	// @ weight: new weight of the edge to it
+	// Changes the weight of the first edge to node; a compressed adjacency list is expanded again first
+	// Returns false if there is no edge to node
+	bool set_adjacent_weight(const Object& node, const Weight& weight)
 	{
-		return adjacent_vertices;
+		if (!compressed_adjacency.empty()) {
+			decompress_adjacency();
+		}
+		for (size_t i = 0; i < adjacent_vertices.size(); i++) {
+			if (adjacent_vertices[i].first == node) {
+				adjacent_vertices[i].second = weight;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	// @ node: name of an adjacent vertex
+	// Removes the first edge to node; a compressed adjacency list is expanded again first
+	// Returns false if there is no edge to node
+	bool remove_adjacent_vertex(const Object& node)
+	{
+		if (!compressed_adjacency.empty()) {
+			decompress_adjacency();
+		}
+		for (size_t i = 0; i < adjacent_vertices.size(); i++) {
+			if (adjacent_vertices[i].first == node) {
+				adjacent_vertices.erase(adjacent_vertices.begin() + i);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	// Returns the adjacent vertices and their weights, whether or not they are compressed
+	// Use it in a range based for loop: for (auto edge : v.adjacent()) { edge.first, edge.second }
+	AdjacencyRange<Object, Weight> adjacent() const
+	{
+		if (compressed_adjacency.empty()) {
+			const pair<Object, Weight>* first = adjacent_vertices.data();
+			return AdjacencyRange<Object, Weight>(AdjacencyIterator<Object, Weight>(first),
+				AdjacencyIterator<Object, Weight>(first + adjacent_vertices.size()));
+		}
+
+		// Skip the encoding byte, and for UINT16 the lowest weight and step
+		const unsigned char* bytes = compressed_adjacency.data();
+		const unsigned char* end = bytes + compressed_adjacency.size();
+		WeightEncoding encoding = static_cast<WeightEncoding>(*bytes++);
+		float lowest = 0, step = 0;
+		if (encoding == WeightEncoding::UINT16) {
+			lowest = read_raw<float>(bytes);
+			step = read_raw<float>(bytes);
+		}
+		int64_t own_id = static_cast<int64_t>(vertex_name);
+		return AdjacencyRange<Object, Weight>(AdjacencyIterator<Object, Weight>(bytes, end, encoding, lowest, step, own_id),
+			AdjacencyIterator<Object, Weight>(end, end, encoding, lowest, step, own_id));
+	}
+
+	// Returns the number of adjacent vertices
+	size_t adjacent_count() const
+	{
+		if (compressed_adjacency.empty()) {
+			return adjacent_vertices.size();
+		}
+		size_t count = 0;
+		for (auto itr = adjacent().begin(), end = adjacent().end(); itr != end; ++itr) {
+			count++;
+		}
+		return count;
+	}
+
+	// @ encoding: how to store the weights
+	// Stores the adjacent vertices in compressed form; see CompressedAdjacency.h
+	// The adjacent vertices are sorted by ID as part of the compression
+	void compress_adjacency(WeightEncoding encoding)
+	{
+		if (!compressed_adjacency.empty()) {
+			decompress_adjacency();
+		}
+		compressed_adjacency = compress_adjacency_list(vertex_name, adjacent_vertices, encoding);
+		vector<pair<Object, Weight>>().swap(adjacent_vertices);
+	}
+
+	// Stores the adjacent vertices as a plain list again
+	void decompress_adjacency()
+	{
+		vector<pair<Object, Weight>> expanded;
+		for (auto edge : adjacent()) {
+			expanded.push_back(edge);
+		}
+		adjacent_vertices.swap(expanded);
+		vector<unsigned char>().swap(compressed_adjacency);
+	}
+
+	// Returns the number of bytes used to store the adjacent vertices
+	size_t adjacency_bytes() const
+	{
+		return adjacent_vertices.capacity() * sizeof(pair<Object, Weight>) + compressed_adjacency.capacity();
 	}
 
 	// Overload the less than operator so that it operates on the distance variables
-	bool operator< (const Vertex<Object>& rhs) const
+	bool operator< (const Vertex<Object, Weight>& rhs) const
 	{
 		if (distance < rhs.distance)
 		{
@@ -85,7 +188,7 @@ public:
 	}
 
 	// Overload the equality operator so that it compares the Vertex names
-	bool operator== (const Vertex<Object>& rhs) const
+	bool operator== (const Vertex<Object, Weight>& rhs) const
 	{
 		if (vertex_name == rhs.vertex_name)
 		{
@@ -103,7 +206,7 @@ public:
 		return out;
 	}
 
-	void setPath(Object& node) {
+	void setPath(const Object& node) {
 		path = node; 
 	}
 
@@ -115,11 +218,11 @@ public:
 		return path; 
 	}
 
-	void setDistance(const double new_dist) {
+	void setDistance(const Weight new_dist) {
 		distance = new_dist; 
 	}
 
-	double get_distance() const {
+	Weight get_distance() const {
 		return distance; 
 	}
 
@@ -139,11 +242,11 @@ public:
 		return indegree; 
 	}
 
-	void set_minPathCost(double cost) {
+	void set_minPathCost(Weight cost) {
 		minPathCost = cost; 
 	}
 
-	double get_minPathCost() const {
+	Weight get_minPathCost() const {
 		return minPathCost; 
 	}
 
@@ -151,7 +254,10 @@ public:
 private: 
 
 	// Contains a list of the adjacent vertices, and their weights
-	vector<pair<Object, double>> adjacent_vertices; 
+	vector<pair<Object, Weight>> adjacent_vertices; 
+
+	// The adjacent vertices in compressed form; empty unless compress_adjacency() was called
+	vector<unsigned char> compressed_adjacency; 
 
 	// Name of this Vertex 
 	Object vertex_name; 
@@ -160,10 +266,10 @@ private:
 	Object path; 
 
 	// Stores the distance of the vertex in a shortest path algorithm
-	double distance; 
+	Weight distance; 
 
 	// Stores the cost of the minimum path of this Vertex in a shortest path algorithm 
-	double minPathCost;
+	Weight minPathCost;
 
 	// Stores the topological number of the Vertex in a Topological sort 
 	int topNum; 
@@ -172,3 +278,5 @@ private:
 	int indegree; 
 		
 };
+
+#endif
@@ -0,0 +1,251 @@
+/*
+	Author: Vishnu Rampersaud
+	VertexOrdering.h header file
+	Relabels the vertices of a graph so that vertices used together are stored close together in memory
+*/
+#ifndef VERTEX_ORDERING_H
+#define VERTEX_ORDERING_H
+
+#include "Vertex.h"
+#include "NameTable.h"
+#include "Stats.h"
+#include <string>
+#include <vector>
+#include <queue>
+#include <algorithm>
+#include <utility>
+using namespace std;
+
+// Orderings that can be applied to the vertices after the graph is loaded
+// FILE_ORDER: keep the IDs from the graph file
+// BFS: number the vertices in breadth first order, following the edges of the graph
+// RCM: Reverse Cuthill-McKee; breadth first over the undirected graph, lowest degree first, then reversed
+// HUB: hub sorting; vertices with more than the average indegree first, by decreasing indegree
+enum class VertexOrdering { FILE_ORDER, BFS, RCM, HUB };
+
+// @ name: name of an ordering, as given on the command line
+// @ ordering: set to the ordering with this name
+// Returns false if there is no ordering with this name
+inline bool parse_ordering(const string& name, VertexOrdering& ordering)
+{
+	if (name == "file") { ordering = VertexOrdering::FILE_ORDER; }
+	else if (name == "bfs") { ordering = VertexOrdering::BFS; }
+	else if (name == "rcm") { ordering = VertexOrdering::RCM; }
+	else if (name == "hub") { ordering = VertexOrdering::HUB; }
+	else { return false; }
+	return true;
+}
+
+// Returns the name of an ordering
+inline const char* ordering_name(VertexOrdering ordering)
+{
+	switch (ordering) {
+	case VertexOrdering::BFS: return "bfs";
+	case VertexOrdering::RCM: return "rcm";
+	case VertexOrdering::HUB: return "hub";
+	default: return "file";
+	}
+}
+
+// @ adjacency_list: an adjacency list that represents a graph
+// Numbers the vertices in the order a breadth first search reaches them
+// Each search starts from the lowest ID that has not been reached yet
+// Returns new_id, where new_id[id] is the new ID of the vertex with this ID
+template <typename Weight>
+vector<int> bfs_ordering(const vector<Vertex<int, Weight>>& adjacency_list)
+{
+	const int n = adjacency_list.size();
+	vector<int> new_id(n, NO_VERTEX);
+	int next_id = 0;
+
+	queue<int> frontier;
+	for (int root = 0; root < n; root++) {
+		if (new_id[root] != NO_VERTEX) { continue; }
+
+		new_id[root] = next_id++;
+		frontier.push(root);
+		while (!frontier.empty()) {
+			int v = frontier.front();
+			frontier.pop();
+
+			for (auto edge : adjacency_list[v].adjacent()) {
+				int w = edge.first;
+				if (new_id[w] == NO_VERTEX) {
+					new_id[w] = next_id++;
+					frontier.push(w);
+				}
+			}
+		}
+	}
+	return new_id;
+}
+
+// @ adjacency_list: an adjacency list that represents a graph
+// Reverse Cuthill-McKee ordering of the undirected version of the graph
+// Each component is started from its unvisited vertex of lowest degree, and the neighbors of a
+// vertex are numbered by increasing degree; reversing the result keeps the bandwidth low
+// Returns new_id, where new_id[id] is the new ID of the vertex with this ID
+template <typename Weight>
+vector<int> rcm_ordering(const vector<Vertex<int, Weight>>& adjacency_list)
+{
+	const int n = adjacency_list.size();
+
+	// Build the undirected graph in compressed form: the neighbors of v are
+	// neighbors[first[v]] up to neighbors[first[v + 1]]
+	vector<int> first(n + 1, 0);
+	for (int v = 0; v < n; v++) {
+		for (auto edge : adjacency_list[v].adjacent()) {
+			first[v + 1]++;
+			first[edge.first + 1]++;
+		}
+	}
+	for (int v = 0; v < n; v++) {
+		first[v + 1] += first[v];
+	}
+	vector<int> neighbors(first[n]);
+	vector<int> fill(first.begin(), first.end() - 1);
+	for (int v = 0; v < n; v++) {
+		for (auto edge : adjacency_list[v].adjacent()) {
+			int w = edge.first;
+			neighbors[fill[v]++] = w;
+			neighbors[fill[w]++] = v;
+		}
+	}
+
+	// Sort each neighbor list by degree so the breadth first search visits low degree vertices first
+	for (int v = 0; v < n; v++) {
+		sort(neighbors.begin() + first[v], neighbors.begin() + first[v + 1], [&first](int a, int b) {
+			int degree_a = first[a + 1] - first[a], degree_b = first[b + 1] - first[b];
+			return degree_a < degree_b || (degree_a == degree_b && a < b);
+		});
+	}
+
+	// Candidate start vertices, lowest degree first
+	vector<int> by_degree(n);
+	for (int v = 0; v < n; v++) {
+		by_degree[v] = v;
+	}
+	stable_sort(by_degree.begin(), by_degree.end(), [&first](int a, int b) {
+		return first[a + 1] - first[a] < first[b + 1] - first[b];
+	});
+
+	// Cuthill-McKee order; order[k] is the vertex numbered k
+	vector<int> order;
+	order.reserve(n);
+	vector<bool> visited(n, false);
+	for (int s = 0; s < n; s++) {
+		int root = by_degree[s];
+		if (visited[root]) { continue; }
+
+		visited[root] = true;
+		size_t head = order.size();
+		order.push_back(root);
+		while (head < order.size()) {
+			int v = order[head++];
+			for (int i = first[v]; i < first[v + 1]; i++) {
+				int w = neighbors[i];
+				if (!visited[w]) {
+					visited[w] = true;
+					order.push_back(w);
+				}
+			}
+		}
+	}
+
+	// Reverse the order
+	vector<int> new_id(n);
+	for (int k = 0; k < n; k++) {
+		new_id[order[k]] = n - 1 - k;
+	}
+	return new_id;
+}
+
+// @ adjacency_list: an adjacency list that represents a graph
+// Hub sorting: vertices whose indegree is above the average are the ones most often read as
+// neighbors, so they are packed together at the front by decreasing indegree
+// All other vertices keep their relative order from the file
+// Returns new_id, where new_id[id] is the new ID of the vertex with this ID
+template <typename Weight>
+vector<int> hub_ordering(const vector<Vertex<int, Weight>>& adjacency_list)
+{
+	const int n = adjacency_list.size();
+	vector<int> indegree(n, 0);
+	long long number_of_edges = 0;
+	for (int v = 0; v < n; v++) {
+		for (auto edge : adjacency_list[v].adjacent()) {
+			indegree[edge.first]++;
+			number_of_edges++;
+		}
+	}
+
+	vector<int> hubs, others;
+	for (int v = 0; v < n; v++) {
+		if (static_cast<long long>(indegree[v]) * n > number_of_edges) {
+			hubs.push_back(v);
+		}
+		else {
+			others.push_back(v);
+		}
+	}
+	stable_sort(hubs.begin(), hubs.end(), [&indegree](int a, int b) {
+		return indegree[a] > indegree[b];
+	});
+
+	vector<int> new_id(n);
+	int next_id = 0;
+	for (size_t i = 0; i < hubs.size(); i++) {
+		new_id[hubs[i]] = next_id++;
+	}
+	for (size_t i = 0; i < others.size(); i++) {
+		new_id[others[i]] = next_id++;
+	}
+	return new_id;
+}
+
+// @ adjacency_list: an adjacency list that represents a graph
+// @ names: labels of the vertices in the graph
+// @ new_id: new_id[id] is the new ID of the vertex with this ID; must be a permutation
+// Renumbers the vertices of the graph; the labels move with their vertices, so output still shows the original labels
+template <typename Weight>
+void relabel_graph(vector<Vertex<int, Weight>>& adjacency_list, NameTable& names, const vector<int>& new_id)
+{
+	const int n = adjacency_list.size();
+	vector<Vertex<int, Weight>> relabeled(n);
+	for (int v = 0; v < n; v++) {
+		Vertex<int, Weight> vertex(new_id[v]);
+		for (auto edge : adjacency_list[v].adjacent()) {
+			vertex.add_adjacent_vertex(new_id[edge.first], edge.second);
+		}
+		relabeled[new_id[v]] = std::move(vertex);
+	}
+	adjacency_list.swap(relabeled);
+	names.relabel(new_id);
+}
+
+// @ adjacency_list: an adjacency list that represents a graph
+// @ names: labels of the vertices in the graph
+// @ ordering: the ordering to apply
+// Computes the ordering and relabels the graph with it
+// Returns new_id, where new_id[id] is the new ID of the vertex that had this ID when the file was loaded
+// Visiting new_id[0], new_id[1], ... gives the vertices in their original file order
+template <typename Weight>
+vector<int> reorder_vertices(vector<Vertex<int, Weight>>& adjacency_list, NameTable& names, VertexOrdering ordering)
+{
+	STATS_PHASE(reorder_timer, "reorder");
+	vector<int> new_id;
+	switch (ordering) {
+	case VertexOrdering::BFS: new_id = bfs_ordering(adjacency_list); break;
+	case VertexOrdering::RCM: new_id = rcm_ordering(adjacency_list); break;
+	case VertexOrdering::HUB: new_id = hub_ordering(adjacency_list); break;
+	default:
+		new_id.resize(adjacency_list.size());
+		for (size_t v = 0; v < new_id.size(); v++) {
+			new_id[v] = v;
+		}
+		return new_id;
+	}
+	relabel_graph(adjacency_list, names, new_id);
+	return new_id;
+}
+
+#endif
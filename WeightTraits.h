@@ -0,0 +1,81 @@
+/*
+	Author: Vishnu Rampersaud
+	WeightTraits.h header file
+	Describes the type used for edge weights and path costs
+*/
+#ifndef WEIGHT_TRAITS_H
+#define WEIGHT_TRAITS_H
+
+#include <limits>
+#include <cstdint>
+#include <cmath>
+using namespace std;
+
+// Edge weight type used by the programs; chosen at compile time, e.g.
+//     make WEIGHT_TYPE=float all
+//     make WEIGHT_TYPE=uint32_t all
+// Small integer weights make every edge and every distance smaller, and use integer compares
+// Integer weight types must be unsigned, and the programs refuse graphs with negative weights
+#ifndef GRAPH_WEIGHT_TYPE
+#define GRAPH_WEIGHT_TYPE double
+#endif
+typedef GRAPH_WEIGHT_TYPE weight_type;
+
+// WeightTraits class
+// What the shortest path algorithms need to know about a weight type:
+// infinity() is the distance of a vertex that has not been reached, and add() never goes past it,
+// so relaxing an edge out of an unreached vertex (or a very long path) cannot overflow
+template <typename Weight, bool is_integer = numeric_limits<Weight>::is_integer>
+struct WeightTraits;
+
+// Floating point weights; infinity is the IEEE infinity, which addition already preserves
+template <typename Weight>
+struct WeightTraits<Weight, false> {
+
+	static Weight infinity()
+	{
+		return numeric_limits<Weight>::infinity();
+	}
+
+	static Weight add(Weight a, Weight b)
+	{
+		return a + b;
+	}
+
+	// Converts a weight read from a graph file
+	static Weight from_double(double weight)
+	{
+		return static_cast<Weight>(weight);
+	}
+};
+
+// Integer weights; the largest value stands for infinity, and addition saturates at it
+// The saturating add() relies on wrap-around free unsigned arithmetic and non-negative b
+template <typename Weight>
+struct WeightTraits<Weight, true> {
+	static_assert(!numeric_limits<Weight>::is_signed, "integer weight types must be unsigned, e.g. uint32_t or uint16_t");
+
+	static Weight infinity()
+	{
+		return numeric_limits<Weight>::max();
+	}
+
+	static Weight add(Weight a, Weight b)
+	{
+		if (a >= infinity() - b) {
+			return infinity();
+		}
+		return a + b;
+	}
+
+	// Converts a weight read from a graph file, rounding to the nearest integer; weight must not be negative
+	static Weight from_double(double weight)
+	{
+		if (weight >= static_cast<double>(infinity())) {
+			return infinity();
+		}
+		return static_cast<Weight>(llround(weight));
+	}
+};
+
+#endif
@@ -4,16 +4,77 @@
 	binary_heap.h header file for the binary heap class 
 	This class is used to implement a priority queue for Dijkstra's algorithm. 
 
-	I added the decreaseKey function. All other code below was provided by Professor Stamos, 
+	I added the decreaseKey function and the optional position index. All other code below was provided by Professor Stamos, 
 	and sourced from Data Structures and Algorithm Analysis in C++, 4th edition, by Mark Allen Weiss.
 */
 #ifndef BINARY_HEAP_H
 #define BINARY_HEAP_H
 
 #include "dsexceptions.h"
+#include "Stats.h"
 #include <vector>
+#include <algorithm>
+#include <type_traits>
 using namespace std;
 
+// Position index of a BinaryHeap: tells decreaseKey() where an item is, instead of searching the heap array
+// The default, NoHeapIndex, keeps nothing, and decreaseKey() searches the array for an equal item (O(n))
+// HeapIndex<KeyOf> keeps the slot of every item by an integer key, KeyOf()(item), so decreaseKey() is O(log n);
+// there may be only one item with each key in the heap
+struct NoHeapIndex
+{
+	static const bool indexed = false;
+
+	template <typename Comparable>
+	void place( const Comparable &, int ) { }
+
+	template <typename Comparable>
+	void remove( const Comparable & ) { }
+
+	template <typename Comparable>
+	int find( const Comparable & ) const { return 0; }
+
+	void clear( ) { }
+};
+
+template <typename KeyOf>
+struct HeapIndex
+{
+	static const bool indexed = true;
+
+	// Records that item is now in slot hole of the heap array
+	template <typename Comparable>
+	void place( const Comparable & item, int hole )
+	{
+		size_t key = KeyOf( )( item );
+		if( key >= slot.size( ) )
+			slot.resize( max( key + 1, slot.size( ) * 2 ), 0 );
+		slot[ key ] = hole;
+	}
+
+	// Records that item has left the heap
+	template <typename Comparable>
+	void remove( const Comparable & item )
+	{
+		slot[ KeyOf( )( item ) ] = 0;
+	}
+
+	// Returns the slot of the item with the same key, or 0 if there is none in the heap
+	template <typename Comparable>
+	int find( const Comparable & item ) const
+	{
+		size_t key = KeyOf( )( item );
+		return key < slot.size( ) ? slot[ key ] : 0;
+	}
+
+	void clear( )
+	{
+		fill( slot.begin( ), slot.end( ), 0 );
+	}
+
+	vector<int> slot;
+};
+
 // BinaryHeap class
 //
 // CONSTRUCTION: with an optional capacity (that defaults to 100)
@@ -25,12 +86,13 @@ using namespace std;
 // bool isEmpty( )        --> Return true if empty; else false
 // void makeEmpty( )      --> Remove all items
 // void decreaseKey(node) --> Decrease the priority of a node in the heap
+//                            (O(log n) with a HeapIndex, else O(n))
 // ******************ERRORS********************************
 // Throws UnderflowException as warranted
 
 // BinaryHeap class 
 // Implements a binary heap which can be used for priority queue purposes
-template <typename Comparable>
+template <typename Comparable, typename Index = NoHeapIndex>
 class BinaryHeap
 {
   public:
@@ -43,10 +105,13 @@ class BinaryHeap
 
 	// Constructor that builds a binary heap out of an array 
     explicit BinaryHeap( const vector<Comparable> & items )
-      : array( items.size( ) + 10 ), currentSize{ items.size( ) }
+      : array( items.size( ) + 10 ), currentSize{ static_cast<int>( items.size( ) ) }
     {
-        for( int i = 0; i < items.size( ); ++i )
+        for( size_t i = 0; i < items.size( ); ++i )
+        {
             array[ i + 1 ] = items[ i ];
+            index.place( array[ i + 1 ], i + 1 );
+        }
         buildHeap( );
     }
 	
@@ -71,30 +136,30 @@ class BinaryHeap
 	*/
 	void decreaseKey(Comparable& node)
 	{
+		STATS_COUNT(heap_decrease_keys);
+
 		// variable to hold the index of the desired item
-		int x; 
+		int x = findSlot(node, integral_constant<bool, Index::indexed>()); 
 
-		// find the location of the item and update its value 
-		for (int i = 0; i < array.size(); i++) {
-			if (array[i] == node) {
-				array[i] = node; 
-				x = i; 
-				break; 
-			}
-			else if (i == array.size() - 1) {
-				std::cout << "node not found in heap; Cannot change priority" << std::endl;
-				return; 
-			}
+		// update its value 
+		if (x == 0) {
+			std::cout << "node not found in heap; Cannot change priority" << std::endl;
+			return; 
 		}
+		array[x] = node; 
 
 		// Percolate up 
 		int hole = x;	// set hole to the updated item location/ index 
 		Comparable copy = array[ x ];
 
+		// Compare against the copy in slot 0; array[ x ] is overwritten by the first move
 		array[0] = std::move(copy);
-		for (; array[ x ] < array[hole / 2]; hole /= 2)
+		for (; array[0] < array[hole / 2]; hole /= 2) {
 			array[hole] = std::move(array[hole / 2]);
+			index.place(array[hole], hole);
+		}
 		array[hole] = std::move(array[0]);
+		index.place(array[hole], hole);
 	}
     
     /**
@@ -102,7 +167,8 @@ class BinaryHeap
      */
     void insert( const Comparable & x )
     {
-        if( currentSize == array.size( ) - 1 )
+        STATS_COUNT(heap_inserts);
+        if( currentSize == static_cast<int>( array.size( ) ) - 1 )
             array.resize( array.size( ) * 2 );
 
             // Percolate up
@@ -111,8 +177,12 @@ class BinaryHeap
         
         array[ 0 ] = std::move( copy );
         for( ; x < array[ hole / 2 ]; hole /= 2 )
+        {
             array[ hole ] = std::move( array[ hole / 2 ] );
+            index.place( array[ hole ], hole );
+        }
         array[ hole ] = std::move( array[ 0 ] );
+        index.place( array[ hole ], hole );
     }
     
 
@@ -121,14 +191,19 @@ class BinaryHeap
      */
     void insert( Comparable && x )
     {
-        if( currentSize == array.size( ) - 1 )
+        STATS_COUNT(heap_inserts);
+        if( currentSize == static_cast<int>( array.size( ) ) - 1 )
             array.resize( array.size( ) * 2 );
 
             // Percolate up
         int hole = ++currentSize;
         for( ; hole > 1 && x < array[ hole / 2 ]; hole /= 2 )
+        {
             array[ hole ] = std::move( array[ hole / 2 ] );
+            index.place( array[ hole ], hole );
+        }
         array[ hole ] = std::move( x );
+        index.place( array[ hole ], hole );
     }
     
     /**
@@ -140,8 +215,11 @@ class BinaryHeap
         if( isEmpty( ) )
             throw UnderflowException{ };
 
+        STATS_COUNT(heap_delete_mins);
+        index.remove( array[ 1 ] );
         array[ 1 ] = std::move( array[ currentSize-- ] );
-        percolateDown( 1 );
+        if( !isEmpty( ) )
+            percolateDown( 1 );
     }
 
     /**
@@ -153,17 +231,40 @@ class BinaryHeap
         if( isEmpty( ) )
             throw UnderflowException{ };
 
+        STATS_COUNT(heap_delete_mins);
         minItem = std::move( array[ 1 ] );
+        index.remove( minItem );
         array[ 1 ] = std::move( array[ currentSize-- ] );
-        percolateDown( 1 );
+        if( !isEmpty( ) )
+            percolateDown( 1 );
     }
 
     void makeEmpty( )
-      { currentSize = 0; }
+      { currentSize = 0; index.clear( ); }
 
   private:
-    int                currentSize;  // Number of elements in heap
     vector<Comparable> array;        // The heap array
+    int                currentSize;  // Number of elements in heap
+    Index              index;        // Slot of each item, for decreaseKey
+
+	// Returns the slot of the item equal to node, or 0 if it is not in the heap
+	// Only slots 1 to currentSize hold live items; slots past the end still hold
+	// copies of items that were already deleted, and slot 0 is scratch space
+	int findSlot(const Comparable& node, false_type) const
+	{
+		for (int i = 1; i <= currentSize; i++) {
+			if (array[i] == node) {
+				return i; 
+			}
+		}
+		return 0; 
+	}
+
+	// Returns the slot of the item with the same key as node from the index, or 0 if it is not in the heap
+	int findSlot(const Comparable& node, true_type) const
+	{
+		return index.find(node); 
+	}
 
     /**
      * Establish heap order property from an arbitrary
@@ -190,11 +291,15 @@ class BinaryHeap
             if( child != currentSize && array[ child + 1 ] < array[ child ] )
                 ++child;
             if( array[ child ] < tmp )
+            {
                 array[ hole ] = std::move( array[ child ] );
+                index.place( array[ hole ], hole );
+            }
             else
                 break;
         }
         array[ hole ] = std::move( tmp );
+        index.place( array[ hole ], hole );
     }
 };
 